@@ -0,0 +1,225 @@
+/**
+ * @file    Batch.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "Batch.hpp"
+#include "Stats.hpp"
+
+#if defined(__x86_64__)
+#define BATCH_X86
+#endif
+
+#ifdef BATCH_X86
+
+/**
+ * Векторы из 4 и 8 64-битных чисел, в каждом элементе (дорожке)
+ * хранится свой многочлен. Операции над векторами выполняются
+ * для всех дорожек одновременно командами AVX2 или AVX-512.
+ */
+typedef uint64_t v4u64 __attribute__((vector_size(32)));
+typedef uint64_t v8u64 __attribute__((vector_size(64)));
+
+/**
+ * Проверяет на неприводимость по одному многочлену в каждой дорожке вектора.
+ * Все шаги алгоритма Берлекампа выполняются без ветвлений по данным,
+ * вместо них используются маски: в маске все биты дорожки равны единице,
+ * если условие для многочлена этой дорожки выполнено, иначе нулю.
+ * Первый шаг - производная, многочлены с нулевой производной отбрасываются.
+ * Второй шаг - НОД многочлена и производной бинарным алгоритмом: пока b != 0,
+ * если b делится на x, то b /= x (a не делится на x), иначе меньший из двух
+ * многочленов остаётся в a, а b заменяется их суммой (она делится на x).
+ * Число шагов для всех дорожек одинаково и ограничено учетверённой степенью.
+ * Третий шаг - ранг матрицы Берлекампа. Строки матрицы по очереди
+ * добавляются в базис, в котором каждый вектор отвечает за свой старший бит:
+ * старшие биты строки по очереди обнуляются векторами базиса, а если
+ * вектора для очередного бита ещё нет, строка становится им. Ранг матрицы
+ * равен числу векторов в базисе, при этом порядок шагов от данных не зависит.
+ * Одновременно обрабатываются G векторов: цепочки зависимых операций
+ * у них независимы, поэтому процессор выполняет их параллельно.
+ * @tparam V тип вектора.
+ * @tparam L число дорожек в векторе.
+ * @tparam G число векторов.
+ * @param[in] polys L * G многочленов степени degree.
+ * @param[out] res результаты проверки для каждого многочлена.
+ * @param[in] degree степень многочленов, от 2 до 63.
+ */
+template<typename V, std::size_t L, std::size_t G>
+static inline __attribute__((always_inline))
+void lanes(const uint_fast64_t *const polys, bool *const res, const uint_fast8_t degree) noexcept {
+    V p[G], a[G], b[G], alive[G], c, d, m;
+    const V zero = {}, one = zero + 1u;
+    std::size_t g, l;
+    for (g = 0; g < G; ++g) {
+        for (l = 0; l < L; ++l) { p[g][l] = polys[g * L + l]; }
+        // производная и свободный член (иначе делится на x)
+        b[g] = (p[g] & 0xAA'AA'AA'AA'AA'AA'AA'AAull) >> 1u;
+        alive[g] = V(b[g] != zero) & V((p[g] & one) != zero);
+        a[g] = p[g];
+    }
+
+    // НОД(p, p'), a всегда не делится на x
+    for (uint_fast16_t step = 0; step < 4u * degree; step += 8) {
+        for (uint_fast8_t k = 0; k < 8; ++k) {
+            for (g = 0; g < G; ++g) {
+                m = V((b[g] & one) == zero);          // b делится на x
+                c = V(a[g] > b[g]);                   // a старше b
+                d = (a[g] & c) | (b[g] & ~c);         // старший из двух
+                c &= ~m;                              // a заменяется на b
+                a[g] = (b[g] & c) | (a[g] & ~c);
+                b[g] = ((b[g] >> 1u) & m) | ((d ^ a[g]) & ~m);
+            }
+        }
+        d = zero;
+        for (g = 0; g < G; ++g) { d |= b[g]; }
+        uint_fast64_t any = 0;
+        for (l = 0; l < L; ++l) { any |= d[l]; }
+        if (any == 0) { break; }
+    }
+    d = zero;
+    for (g = 0; g < G; ++g) {
+        alive[g] &= V(a[g] == one);
+        d |= alive[g];
+    }
+    uint_fast64_t any = 0;
+    for (l = 0; l < L; ++l) { any |= d[l]; }
+    if (any == 0) {
+        for (l = 0; l < L * G; ++l) { res[l] = false; }
+        return;
+    }
+
+    // ранг матрицы Берлекампа
+    V basis[G][63], rank[G], row[G], t[G];
+    for (g = 0; g < G; ++g) {
+        for (uint_fast8_t i = 0; i < degree; ++i) { basis[g][i] = zero; }
+        rank[g] = zero;
+        t[g] = one;
+    }
+    for (uint_fast8_t i = 0; i < degree; ++i) {
+        for (g = 0; g < G; ++g) {
+            row[g] = t[g] ^ (1ull << i); // M -= E (mod 2)
+            m = zero - ((t[g] >> (degree - 1u)) & one);
+            t[g] = (t[g] << 1u) ^ (p[g] & m);
+            m = zero - ((t[g] >> (degree - 1u)) & one);
+            t[g] = (t[g] << 1u) ^ (p[g] & m);
+        }
+        for (uint_fast8_t j = degree; j-- > 0;) {
+            for (g = 0; g < G; ++g) {
+                m = V((row[g] & (1ull << j)) != zero); // у строки есть бит j
+                c = V(basis[g][j] == zero) & m;         // вектора для бита j ещё нет
+                basis[g][j] |= row[g] & c;
+                rank[g] -= c;                           // маска равна -1
+                row[g] ^= basis[g][j] & m;
+            }
+        }
+    }
+    for (g = 0; g < G; ++g) {
+        for (l = 0; l < L; ++l) {
+            res[g * L + l] = alive[g][l] != 0 && rank[g][l] == degree - 1u;
+        }
+    }
+}
+
+/**
+ * Проверка 16 многочленов командами AVX-512.
+ */
+static __attribute__((target("avx512f")))
+void check16(const uint_fast64_t *const polys, bool *const res, const uint_fast8_t degree) noexcept {
+    lanes<v8u64, 8, 2>(polys, res, degree);
+}
+
+/**
+ * Проверка 8 многочленов командами AVX2.
+ */
+static __attribute__((target("avx2")))
+void check8(const uint_fast64_t *const polys, bool *const res, const uint_fast8_t degree) noexcept {
+    lanes<v4u64, 4, 2>(polys, res, degree);
+}
+
+#endif
+
+/**
+ * Наибольшее число многочленов, проверяемых одновременно (см. Batch::Limit).
+ */
+static std::atomic<uint_fast8_t> limit(16);
+
+/**
+ * Определяет один раз за время работы программы, какие векторные команды
+ * поддерживает процессор.
+ * @return число многочленов, проверяемых одновременно:
+ * 16 для AVX-512, 8 для AVX2 (по два вектора),
+ * 1 если векторные команды не поддерживаются или запрещены вызовом Limit.
+ */
+[[nodiscard]]
+uint_fast8_t Batch::Lanes() noexcept {
+#ifdef BATCH_X86
+    static const uint_fast8_t res = __builtin_cpu_supports("avx512f") ? 16 :
+                                    __builtin_cpu_supports("avx2") ? 8 : 1;
+    const uint_fast8_t l = limit.load(std::memory_order_relaxed);
+    return res <= l ? res : l >= 8 ? 8 : 1;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * Ограничивает число многочленов, проверяемых одновременно, например
+ * чтобы сравнить на одном процессоре результаты всех вариантов проверки.
+ * Действует на все последующие вызовы Check во всех потоках.
+ * @param[in] lanes 16 - без ограничений, 8 - не больше AVX2, 1 - по одному.
+ */
+void Batch::Limit(const uint_fast8_t lanes) noexcept {
+    limit.store(lanes, std::memory_order_relaxed);
+}
+
+/**
+ * Проверяет на неприводимость набор многочленов одной степени.
+ * Алгоритмом Берлекампа многочлены обрабатываются группами по Lanes() штук,
+ * в каждой группе все шаги алгоритма выполняются одновременно для всех
+ * многочленов. Остаток, не заполняющий группу целиком, многочлены первой
+ * степени и многочлены, проверяемые алгоритмом Рабина, проверяются по одному.
+ * По замерам на случайных многочленах группы до 55 степени включительно
+ * для AVX-512 и до 31 степени для AVX2 проверяются алгоритмом Берлекампа
+ * быстрее, чем по одному алгоритмом Рабина, поэтому по умолчанию (Auto)
+ * алгоритм выбирается по этой границе.
+ * @param[in] polys многочлены для проверки.
+ * @param[out] res результаты проверки, res[i] - неприводим ли polys[i].
+ * @param[in] count число многочленов.
+ * @param[in] degree степень всех многочленов, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[in] method алгоритм проверки.
+ */
+void Batch::Check(
+        const uint_fast64_t *const polys, bool *const res, const std::size_t count,
+        const uint_fast8_t degree, Polynomial<>::Method method
+) noexcept {
+    // степень, начиная с которой проверка по одному алгоритмом Рабина быстрее
+    const uint_fast8_t crossover = Lanes() == 16 ? 56 : Lanes() == 8 ? 32 : 0;
+
+    if (method == Polynomial<>::Method::Auto) {
+        method = degree < crossover ?
+                 Polynomial<>::Method::Berlekamp : Polynomial<>::Choose(degree);
+    }
+    std::size_t i = 0;
+#ifdef BATCH_X86
+    const uint_fast8_t l = degree > 1 && method == Polynomial<>::Method::Berlekamp ? Lanes() : 1;
+    STATS_CLOCK(t);
+    if (l == 16) {
+        for (; i + 16 <= count; i += 16) { check16(polys + i, res + i, degree); }
+    } else if (l == 8) {
+        for (; i + 8 <= count; i += 8) { check8(polys + i, res + i, degree); }
+    }
+    if (i) { STATS_LAP(t, Batch, degree, i, i - std::count(res, res + i, true)); }
+#endif
+    uint_fast64_t M[63];
+    for (; i < count; ++i) {
+        res[i] = Polynomial(polys[i]).IsIrredusible(degree, M, method);
+    }
+}
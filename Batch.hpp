@@ -0,0 +1,30 @@
+/**
+ * @file    Batch.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_BATCH_HPP
+#define BERLEKAMP_BATCH_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include "Polynomial.hpp"
+
+class Batch {
+public:
+    [[nodiscard]] static
+    uint_fast8_t Lanes() noexcept;
+
+    static
+    void Limit(uint_fast8_t) noexcept;
+
+    static
+    void Check(const uint_fast64_t *, bool *, std::size_t, uint_fast8_t,
+               Polynomial<>::Method = Polynomial<>::Method::Auto) noexcept;
+};
+
+#endif //BERLEKAMP_BATCH_HPP
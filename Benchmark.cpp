@@ -0,0 +1,361 @@
+/**
+ * @file    Benchmark.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include "Batch.hpp"
+#include "Clmul.hpp"
+#include "Dispatcher.hpp"
+#include "Enumerator.hpp"
+#include "Field.hpp"
+#include "Generator.hpp"
+#include "Lyndon.hpp"
+#include "Polynomial.hpp"
+#include "Rank.hpp"
+#include "Xoshiro.hpp"
+#include "Benchmark.hpp"
+
+/**
+ * Создаёт набор замеров. Кандидаты для каждой степени генерируются
+ * xoshiro256** из заданного начального значения, поэтому все запуски
+ * с одинаковыми параметрами измеряют одни и те же многочлены.
+ * @param[in] seed начальное значение генератора кандидатов.
+ * @param[in] count число кандидатов каждой степени.
+ * @param[in] threads число рабочих потоков генератора, 0 - по числу ядер.
+ */
+Benchmark::Benchmark(const uint_fast64_t seed, const std::size_t count, const uint_fast8_t threads) noexcept :
+        seed(seed), count(count), threads(threads), repeat(3), sink(0) {}
+
+/**
+ * Замеряет ступень: выполняет body repeat раз и берёт наименьшее время,
+ * т.к. остальные запуски отличаются от него только помехами.
+ * @param[in] stage название ступени.
+ * @param[in] degree степень многочленов.
+ * @param[in] ops число операций, выполняемых одним вызовом body.
+ * @param[in] body замеряемый код, возвращает контрольную сумму,
+ * не позволяющую компилятору выбросить вычисления.
+ */
+template<typename Body>
+void Benchmark::measure(
+        const char *const stage, const uint_fast8_t degree, const std::size_t ops, const Body &body
+) noexcept {
+    if (ops == 0) { return; }
+    auto best = std::chrono::nanoseconds::max();
+    for (uint_fast8_t r = 0; r < repeat; ++r) {
+        const auto t0 = std::chrono::steady_clock::now();
+        sink += body();
+        const auto t1 = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0));
+    }
+    results.push_back(Result{stage, degree, static_cast<double>(best.count()) / static_cast<double>(ops)});
+}
+
+/**
+ * Замеряет ступени проверки одного многочлена степени degree:
+ * производную, НОД с производной, приведение 64-битного многочлена
+ * делением и 128-битного произведения методом Барретта, построение
+ * матрицы Берлекампа, её ранг (переносимый и в векторных регистрах;
+ * время построения матрицы вычитается), полную проверку IsIrredusible
+ * и групповую проверку Batch::Check.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ */
+void Benchmark::stages(const uint_fast8_t degree) noexcept {
+    Xoshiro rng(seed + degree);
+    polys.resize(count);
+    other.resize(count);
+    for (std::size_t i = 0; i < count; ++i) {
+        polys[i] = (1ull << degree) | (rng.Next() >> (64u - degree)) | 1ull;
+        other[i] = rng.Next() >> (64u - degree);
+    }
+    std::vector<uint_fast64_t> M(63);
+
+    measure("derivative", degree, count, [this] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) { s ^= Polynomial(p).derivative(); }
+        return s;
+    });
+    measure("gcd", degree, count, [this] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) { s ^= Polynomial<>::gcd(p, Polynomial(p).derivative()); }
+        return s;
+    });
+    measure("mod64", degree, count, [this, degree] {
+        uint_fast64_t s = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            s ^= Polynomial<>::mod(polys[i] * 0x9E'37'79'B9'7F'4A'7C'15ull, polys[i], degree);
+        }
+        return s;
+    });
+    std::vector<Clmul> barrett;
+    barrett.reserve(count);
+    for (auto p : polys) { barrett.emplace_back(p, degree); }
+    measure("mod128", degree, count, [this, &barrett] {
+        uint_fast64_t s = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            s ^= barrett[i].Reduce(Clmul::Product(other[i], other[(i + 1) % count]));
+        }
+        return s;
+    });
+    if (degree < 2) { return; }
+
+    measure("matrix", degree, count, [this, degree, &M] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) {
+            Polynomial(p).BerlekampMatrix(degree, M.data());
+            s ^= M[degree - 1u];
+        }
+        return s;
+    });
+    const double matrix = results.back().ns;
+    measure("rank_portable", degree, count, [this, degree, &M] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) {
+            Polynomial(p).BerlekampMatrix(degree, M.data());
+            s += Rank::Portable(M.data(), degree);
+        }
+        return s;
+    });
+    results.back().ns = std::max(results.back().ns - matrix, 0.0);
+    measure("rank", degree, count, [this, degree, &M] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) {
+            Polynomial(p).BerlekampMatrix(degree, M.data());
+            s += Rank::Get(M.data(), degree);
+        }
+        return s;
+    });
+    results.back().ns = std::max(results.back().ns - matrix, 0.0);
+    measure("irreducible", degree, count, [this, degree, &M] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) { s += Polynomial(p).IsIrredusible(degree, M.data()); }
+        return s;
+    });
+    measure("batch", degree, count, [this, degree] {
+        bool res[16];
+        uint_fast64_t s = 0;
+        for (std::size_t i = 0; i < count; i += 16) {
+            const std::size_t k = std::min<std::size_t>(16, count - i);
+            Batch::Check(polys.data() + i, res, k, degree);
+            s += std::count(res, res + k, true);
+        }
+        return s;
+    });
+}
+
+/**
+ * Замеряет задержку одного вызова GetIrrPoly, пропускную способность
+ * GetIrrPolys (время на один найденный многочлен) и Dispatcher::GetIrrPoly
+ * (время на один из одновременных запросов) для степени degree.
+ * Генератор каждый раз получает одно и то же начальное значение,
+ * поэтому проверяются одни и те же кандидаты.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ */
+void Benchmark::generator(const uint_fast8_t degree) noexcept {
+    Generator g(threads);
+    const std::size_t calls = std::max<std::size_t>(count / 100, 1);
+    g.SetSeed(seed);
+    measure("get_irr_poly", degree, calls, [&g, degree, calls] {
+        uint_fast64_t s = 0;
+        for (std::size_t i = 0; i < calls; ++i) { s ^= g.GetIrrPoly(degree); }
+        return s;
+    });
+    // заведомо меньше числа неприводимых многочленов степени degree
+    const std::size_t many = degree < 4 ? 0 : std::min<std::size_t>(count / 10, (1ull << degree) / (4u * degree));
+    g.SetSeed(seed);
+    measure("get_irr_polys", degree, many, [&g, degree, many] {
+        uint_fast64_t s = 0;
+        for (auto p : g.GetIrrPolys(degree, many)) { s ^= p; }
+        return s;
+    });
+    // те же calls запросов, но поставленные в очередь одновременно
+    Dispatcher dispatcher(threads);
+    measure("dispatcher", degree, calls, [&dispatcher, degree, calls] {
+        std::vector<std::future<uint_fast64_t>> results;
+        results.reserve(calls);
+        for (std::size_t i = 0; i < calls; ++i) { results.push_back(dispatcher.GetIrrPoly(degree)); }
+        uint_fast64_t s = 0;
+        for (auto &r : results) { s ^= r.get(); }
+        return s;
+    });
+}
+
+/**
+ * Замеряет арифметику поля GF(2^degree), построенного по наименьшему
+ * неприводимому многочлену степени: умножение и обращение по одному
+ * элементу и массивами (см. Field). Использует кандидатов из stages
+ * как элементы поля.
+ * @param[in] degree степень поля, от 1 до 63.
+ */
+void Benchmark::field(const uint_fast8_t degree) noexcept {
+    const Field f(Polynomial<>::First(degree));
+    const uint_fast64_t mask = (1ull << degree) - 1ull;
+    for (std::size_t i = 0; i < count; ++i) {
+        polys[i] &= mask;
+        other[i] &= mask;
+    }
+    std::vector<uint_fast64_t> res(count);
+    measure("field_mul", degree, count, [this, &f] {
+        uint_fast64_t s = 0;
+        for (std::size_t i = 0; i < count; ++i) { s ^= f.Mul(polys[i], other[i]); }
+        return s;
+    });
+    measure("field_mul_batch", degree, count, [this, &f, &res] {
+        f.Mul(polys.data(), other.data(), res.data(), count);
+        return res[count / 2];
+    });
+    measure("field_inv", degree, count, [this, &f] {
+        uint_fast64_t s = 0;
+        for (auto p : polys) { s ^= f.Inv(p); }
+        return s;
+    });
+    measure("field_inv_batch", degree, count, [this, &f, &res] {
+        f.Inv(polys.data(), res.data(), count);
+        return res[count / 2];
+    });
+}
+
+/**
+ * Выполняет все замеры для степеней от from до to включительно.
+ * @param[in] from наименьшая степень, от 1 до 63.
+ * @param[in] to наибольшая степень, от from до 63.
+ */
+void Benchmark::Run(const uint_fast8_t from, const uint_fast8_t to) noexcept {
+    for (uint_fast8_t d = from; d <= to; ++d) {
+        stages(d);
+        field(d);
+        generator(d);
+    }
+}
+
+/**
+ * Замеряет полный перебор всех кандидатов каждой степени от 2 до to
+ * (см. Enumerator::Count), как в бенчмарке из README, и перечисление
+ * тех же многочленов через слова Линдона (см. Lyndon::Enumerate).
+ * Время перебора приводится к одному кандидату (многочлену с ненулевыми
+ * младшим и старшим коэффициентами), время перечисления - к одному
+ * найденному многочлену.
+ * @param[in] to наибольшая степень, от 2 до 63; перебор степени n
+ * занимает время порядка 2^(n-1) проверок.
+ */
+void Benchmark::Enumerate(const uint_fast8_t to) noexcept {
+    Enumerator enumerator;
+    Lyndon lyndon;
+    const uint_fast8_t saved = repeat;
+    repeat = 1;
+    for (uint_fast8_t d = 2; d <= to; ++d) {
+        measure("enumerate", d, 1ull << (d - 1u), [&enumerator, d] {
+            return enumerator.Count(d);
+        });
+        measure("lyndon", d, Polynomial<>::Count(d), [&lyndon, d] {
+            return lyndon.Enumerate(d, [](uint_fast64_t) {});
+        });
+    }
+    repeat = saved;
+}
+
+/**
+ * @return результаты выполненных замеров в порядке выполнения.
+ */
+[[nodiscard]]
+const std::vector<Benchmark::Result> &Benchmark::Results() const noexcept {
+    return results;
+}
+
+/**
+ * Записывает результаты в формате JSON: параметры запуска и массив
+ * results, по одному замеру в строке, с временем на операцию в наносекундах
+ * и числом операций (кандидатов, многочленов, вызовов) в секунду.
+ * @param[out] out поток для записи.
+ */
+void Benchmark::Write(std::ostream &out) const noexcept {
+    char line[160];
+    out << "{\n"
+        << "  \"seed\": " << seed << ",\n"
+        << "  \"count\": " << count << ",\n"
+        << "  \"threads\": " << +threads << ",\n"
+        << "  \"lanes\": " << +Batch::Lanes() << ",\n"
+        << "  \"rank_kernel\": " << Rank::Hardware() << ",\n"
+        << "  \"clmul\": " << (Clmul::Hardware() ? "true" : "false") << ",\n"
+        << "  \"checksum\": " << sink << ",\n"
+        << "  \"results\": [\n";
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const auto &r = results[i];
+        std::snprintf(line, sizeof(line),
+                      "    {\"stage\": \"%s\", \"degree\": %u, \"ns_per_op\": %.3f, \"ops_per_sec\": %.0f}%s\n",
+                      r.stage.c_str(), static_cast<unsigned>(r.degree), r.ns,
+                      r.ns > 0 ? 1e9 / r.ns : 0.0, i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * Читает результаты, записанные Write. Разбирается только массив
+ * results, каждый замер которого записан в отдельной строке.
+ * @param[in] in поток с сохранёнными результатами.
+ * @return прочитанные замеры, пустой список, если их нет.
+ */
+[[nodiscard]]
+std::vector<Benchmark::Result> Benchmark::Read(std::istream &in) noexcept {
+    std::vector<Result> res;
+    std::string line;
+    char stage[32];
+    unsigned degree;
+    double ns;
+    while (std::getline(in, line)) {
+        if (std::sscanf(line.c_str(), " {\"stage\": \"%31[^\"]\", \"degree\": %u, \"ns_per_op\": %lf",
+                        stage, &degree, &ns) == 3) {
+            res.push_back(Result{stage, static_cast<uint_fast8_t>(degree), ns});
+        }
+    }
+    return res;
+}
+
+/**
+ * Сравнивает замеры с сохранёнными ранее и выводит отчёт: для каждой
+ * ступени - наибольшее замедление по всем степеням, и каждую пару
+ * (ступень, степень), замедлившуюся больше чем на threshold.
+ * Замеры короче 1 нс не сравниваются: их точности недостаточно.
+ * @param[in] baseline сохранённые замеры.
+ * @param[in] current текущие замеры.
+ * @param[in] threshold допустимое относительное замедление, например 0.1.
+ * @param[out] report поток для отчёта.
+ * @return число замедлившихся больше допустимого замеров.
+ */
+[[nodiscard]]
+std::size_t Benchmark::Compare(
+        const std::vector<Result> &baseline, const std::vector<Result> &current,
+        const double threshold, std::ostream &report
+) noexcept {
+    std::map<std::pair<std::string, uint_fast8_t>, double> base;
+    for (const auto &r : baseline) { base[{r.stage, r.degree}] = r.ns; }
+    std::map<std::string, double> worst;
+    std::size_t regressions = 0;
+    char line[160];
+    for (const auto &r : current) {
+        const auto it = base.find({r.stage, r.degree});
+        if (it == base.end() || it->second < 1.0) { continue; }
+        const double ratio = r.ns / it->second;
+        auto &w = worst.emplace(r.stage, ratio).first->second;
+        w = std::max(w, ratio);
+        if (ratio <= 1.0 + threshold) { continue; }
+        ++regressions;
+        std::snprintf(line, sizeof(line), "regression %-14s degree %2u: %10.3f -> %10.3f ns (%+.1f%%)\n",
+                      r.stage.c_str(), static_cast<unsigned>(r.degree), it->second, r.ns, (ratio - 1.0) * 100.0);
+        report << line;
+    }
+    for (const auto &w : worst) {
+        std::snprintf(line, sizeof(line), "%-14s worst %+.1f%%\n", w.first.c_str(), (w.second - 1.0) * 100.0);
+        report << line;
+    }
+    return regressions;
+}
@@ -0,0 +1,69 @@
+/**
+ * @file    Benchmark.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_BENCHMARK_HPP
+#define BERLEKAMP_BENCHMARK_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+class Benchmark {
+public:
+    /// результат замера одной ступени для одной степени
+    struct Result {
+        std::string stage;
+        uint_fast8_t degree;
+        double ns;
+    };
+
+private:
+    std::vector<Result> results;
+    std::vector<uint_fast64_t> polys;
+    std::vector<uint_fast64_t> other;
+    uint_fast64_t seed;
+    std::size_t count;
+    uint_fast8_t threads;
+    uint_fast8_t repeat;
+    uint_fast64_t sink;
+
+    template<typename Body>
+    void measure(const char *, uint_fast8_t, std::size_t, const Body &) noexcept;
+
+    void stages(uint_fast8_t) noexcept;
+
+    void generator(uint_fast8_t) noexcept;
+
+    void field(uint_fast8_t) noexcept;
+
+public:
+    explicit
+    Benchmark(uint_fast64_t = 1, std::size_t = 100000, uint_fast8_t = 0) noexcept;
+
+    void Run(uint_fast8_t = 1, uint_fast8_t = 63) noexcept;
+
+    void Enumerate(uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    const std::vector<Result> &Results() const noexcept;
+
+    void Write(std::ostream &) const noexcept;
+
+    [[nodiscard]] static
+    std::vector<Result> Read(std::istream &) noexcept;
+
+    [[nodiscard]] static
+    std::size_t Compare(const std::vector<Result> &, const std::vector<Result> &,
+                        double, std::ostream &) noexcept;
+};
+
+#endif //BERLEKAMP_BENCHMARK_HPP
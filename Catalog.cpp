@@ -0,0 +1,418 @@
+/**
+ * @file    Catalog.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Generator.hpp"
+#include "Lyndon.hpp"
+#include "Catalog.hpp"
+
+/**
+ * Заголовок файла каталога. Файл состоит из заголовка, таблицы Entry
+ * для степеней от 0 до 63 и разделов отдельных степеней; все смещения
+ * отсчитываются от начала файла и кратны 8 байтам, поэтому после mmap
+ * данные читаются на месте без копирования. Числа записываются в порядке
+ * байт машины, собравшей каталог; на машине с другим порядком поле order
+ * не совпадёт и файл не откроется.
+ */
+struct Catalog::Header {
+    char magic[8];      ///< "IRRGF2CT"
+    uint64_t order;     ///< 0x0102030405060708
+    uint32_t version;   ///< версия формата, 1
+    uint32_t full;      ///< все неприводимые записаны для степеней до full
+    uint32_t max;       ///< наибольшая записанная степень
+    uint32_t blockSize; ///< Catalog::blockSize
+    uint64_t reserved[4];
+};
+
+/**
+ * Раздел одной степени d. Многочлены p хранятся по возрастанию в виде
+ * v = p - x^d (старший коэффициент всегда единица) блоками по blockSize:
+ * для каждого блока в массиве anchors записаны два слова - первое значение
+ * блока и (ширина разности << 56 | битовое смещение разностей блока
+ * в data), а в data подряд записаны разности v_i - v_(i-1) - 1 остальных
+ * значений блока, каждая ровно в ширину, нужную наибольшей из них.
+ * Массив hints из 2^hintBits + 1 32-битных номеров блоков: hints[t] -
+ * первый блок, старшие hintBits бит первого значения которого не меньше t.
+ */
+struct Catalog::Entry {
+    uint64_t count;    ///< число записанных многочленов
+    uint64_t blocks;   ///< число блоков
+    uint64_t anchors;  ///< смещение массива первых значений блоков
+    uint64_t hints;    ///< смещение массива hints
+    uint64_t data;     ///< смещение разностей
+    uint32_t hintBits; ///< число бит, по которым строится hints
+    uint32_t complete; ///< записаны ли все неприводимые многочлены степени
+    uint64_t reserved[2];
+};
+
+static const char magic[8] = {'I', 'R', 'R', 'G', 'F', '2', 'C', 'T'};
+static const uint64_t order = 0x01'02'03'04'05'06'07'08ull;
+static const uint32_t version = 1;
+
+/**
+ * Читает width бит, начиная с бита pos. За последним значением
+ * в data всегда есть ещё одно слово, поэтому чтение двух слов безопасно.
+ * @param[in] words битовый поток.
+ * @param[in] pos номер первого бита.
+ * @param[in] width число бит, от 0 до 63.
+ * @return прочитанное значение.
+ */
+[[nodiscard]] static
+uint_fast64_t bits(const uint64_t *const words, const uint_fast64_t pos, const uint_fast8_t width) noexcept {
+    if (width == 0) { return 0; }
+    const uint_fast8_t shift = pos & 63u;
+    uint_fast64_t res = words[pos >> 6u] >> shift;
+    if (shift + width > 64) { res |= words[(pos >> 6u) + 1] << (64u - shift); }
+    return res & ((1ull << width) - 1);
+}
+
+/**
+ * Записывает раздел степени degree в конец файла.
+ * @param[in,out] file данные файла после заголовка, по словам.
+ * @param[in] polys все многочлены раздела по возрастанию.
+ * @param[in] degree степень многочленов.
+ * @param[in] offset смещение начала раздела в файле.
+ * @param[out] entry заполняемая запись раздела.
+ */
+void Catalog::encode(
+        std::vector<uint64_t> &file, const std::vector<uint_fast64_t> &polys,
+        const uint_fast8_t degree, const uint64_t offset, Entry &entry
+) noexcept {
+    const uint_fast64_t top = 1ull << degree;
+    const uint64_t blocks = (polys.size() + blockSize - 1) / blockSize;
+    uint32_t h = 0;
+    while (h < degree && (1ull << h) < blocks) { ++h; }
+
+    entry.count = polys.size();
+    entry.blocks = blocks;
+    entry.hintBits = h;
+    entry.anchors = offset;
+    entry.hints = entry.anchors + 16 * blocks;
+    entry.data = entry.hints + 8 * (((1ull << h) + 1 + 1) / 2);
+
+    std::vector<uint64_t> anchors(2 * blocks), data;
+    uint_fast64_t pos = 0;
+    for (uint64_t b = 0; b < blocks; ++b) {
+        const std::size_t first = b * blockSize, last = std::min(first + blockSize, polys.size());
+        uint_fast64_t widest = 0;
+        for (std::size_t i = first + 1; i < last; ++i) {
+            widest = std::max<uint_fast64_t>(widest, polys[i] - polys[i - 1] - 1);
+        }
+        const uint_fast8_t width = widest ? 64u - __builtin_clzll(widest) : 0;
+        anchors[2 * b] = polys[first] ^ top;
+        anchors[2 * b + 1] = uint64_t(width) << 56u | pos;
+        for (std::size_t i = first + 1; i < last; ++i, pos += width) {
+            const uint_fast64_t delta = polys[i] - polys[i - 1] - 1;
+            if ((pos >> 6u) + 1 >= data.size()) { data.resize((pos >> 6u) + 2, 0); }
+            if (width == 0) { continue; }
+            data[pos >> 6u] |= delta << (pos & 63u);
+            if ((pos & 63u) + width > 64) { data[(pos >> 6u) + 1] |= delta >> (64u - (pos & 63u)); }
+        }
+    }
+    // слово за последней разностью для чтения двух слов подряд
+    data.resize((pos >> 6u) + 2, 0);
+
+    std::vector<uint64_t> hints(((1ull << h) + 1 + 1) / 2, 0);
+    uint64_t b = 0;
+    for (uint64_t t = 0; t <= (1ull << h); ++t) {
+        while (b < blocks && (anchors[2 * b] >> (degree - h)) < t) { ++b; }
+        hints[t / 2] |= b << (32u * (t & 1u));
+    }
+    file.insert(file.end(), anchors.begin(), anchors.end());
+    file.insert(file.end(), hints.begin(), hints.end());
+    file.insert(file.end(), data.begin(), data.end());
+}
+
+/**
+ * Строит файл каталога неприводимых многочленов.
+ * Для степеней до full записываются все неприводимые многочлены
+ * (минимальные многочлены по словам Линдона, см. Lyndon), для степеней
+ * от full + 1 до max - samples различных случайных неприводимых многочленов (см. Generator::GetIrrPolys,
+ * начальное значение 1, поэтому файл воспроизводим). Если samples
+ * сравнимо с числом всех неприводимых многочленов степени, степень
+ * перебирается полностью.
+ * @param[in] path путь к создаваемому файлу.
+ * @param[in] full наибольшая степень, записываемая полностью, до 63.
+ * @param[in] max наибольшая записываемая степень, от full до 63.
+ * @param[in] samples число многочленов каждой из старших степеней.
+ * @param[in] threads число рабочих потоков, 0 - по числу потоков в системе.
+ * @return удалось ли записать файл.
+ */
+[[nodiscard]]
+bool Catalog::Build(
+        const char *const path, const uint_fast8_t full, const uint_fast8_t max,
+        const std::size_t samples, const uint_fast8_t threads
+) noexcept {
+    static_assert(sizeof(Header) == 64 && sizeof(Entry) == 64, "catalog layout");
+    if (max == 0 || max > 63 || full > max) { return false; }
+    Lyndon lyndon(threads);
+    Generator generator(threads);
+    generator.SetSeed(1);
+
+    Header header{};
+    std::copy(magic, magic + 8, header.magic);
+    header.order = order;
+    header.version = version;
+    header.full = full;
+    header.max = max;
+    header.blockSize = blockSize;
+    std::array<Entry, 64> entries{};
+    std::vector<uint64_t> file;
+    const uint64_t start = sizeof(Header) + sizeof(entries);
+
+    for (uint_fast8_t d = 1; d <= max; ++d) {
+        std::vector<uint_fast64_t> polys;
+        // неприводимых многочленов степени d не меньше 2^d / 2d
+        const bool complete = d <= full || (1ull << d) / (2 * d) <= samples;
+        if (complete) {
+            (void) lyndon.Enumerate(d, [&polys](const uint_fast64_t p) { polys.push_back(p); });
+        } else if (samples) {
+            polys = generator.GetIrrPolys(d, samples);
+        }
+        if (polys.empty() && (complete || samples)) { return false; }
+        std::sort(polys.begin(), polys.end());
+        entries[d].complete = complete;
+        encode(file, polys, d, start + 8 * file.size(), entries[d]);
+    }
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(entries.data()), sizeof(entries));
+    out.write(reinterpret_cast<const char *>(file.data()), static_cast<std::streamsize>(8 * file.size()));
+    return static_cast<bool>(out.flush());
+}
+
+/**
+ * Создаёт пустой каталог, не содержащий ни одного многочлена.
+ */
+Catalog::Catalog() noexcept : base(nullptr), length(0), index(nullptr) {}
+
+/**
+ * Открывает файл каталога (см. Open).
+ * @param[in] path путь к файлу, построенному Build.
+ */
+Catalog::Catalog(const char *const path) noexcept : Catalog() {
+    (void) Open(path);
+}
+
+/**
+ * Освобождает отображение файла.
+ */
+Catalog::~Catalog() noexcept {
+    Close();
+}
+
+/**
+ * Отображает файл каталога в память только для чтения. Данные не копируются
+ * и не разбираются: проверяются заголовок и границы всех разделов,
+ * после чего каждый запрос читает лишь несколько слов файла.
+ * Ранее открытый файл закрывается.
+ * @param[in] path путь к файлу, построенному Build.
+ * @return удалось ли открыть файл, иначе каталог остаётся пустым.
+ */
+[[nodiscard]]
+bool Catalog::Open(const char *const path) noexcept {
+    Close();
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) { return false; }
+    struct stat st{};
+    const std::size_t size = fstat(fd, &st) == 0 ? static_cast<std::size_t>(st.st_size) : 0;
+    void *map = size >= sizeof(Header) + 64 * sizeof(Entry) ?
+                mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0) : MAP_FAILED;
+    close(fd);
+    if (map == MAP_FAILED) { return false; }
+    base = static_cast<const unsigned char *>(map);
+    length = size;
+    index = reinterpret_cast<const Entry *>(base + sizeof(Header));
+
+    const auto *header = reinterpret_cast<const Header *>(base);
+    bool ok = std::equal(magic, magic + 8, header->magic) && header->order == order &&
+              header->version == version && header->blockSize == blockSize && header->max < 64;
+    for (uint_fast8_t d = 1; ok && d < 64; ++d) {
+        const Entry &e = index[d];
+        // разделы степеней выше max пусты и ни на что не ссылаются
+        if (e.count == 0) {
+            ok = e.blocks == 0;
+            continue;
+        }
+        const uint64_t hints = (1ull << std::min<uint32_t>(e.hintBits, 63)) + 1;
+        ok = e.blocks == (e.count + blockSize - 1) / blockSize && e.hintBits <= d &&
+             e.blocks < (1ull << 32u) && (e.count == 0 || d <= header->max) &&
+             e.anchors % 8 == 0 && e.hints % 8 == 0 && e.data % 8 == 0 &&
+             e.anchors <= length && e.blocks <= (length - e.anchors) / 16 &&
+             e.hints <= length && hints <= (length - e.hints) / 4 && e.data + 8 <= length;
+        const auto *hint = reinterpret_cast<const uint32_t *>(base + e.hints);
+        for (uint64_t t = 0; ok && t < hints; ++t) {
+            ok = hint[t] <= e.blocks && (t == 0 || hint[t - 1] <= hint[t]);
+        }
+        const auto *anchors = reinterpret_cast<const uint64_t *>(base + e.anchors);
+        const uint64_t available = 8 * (length - e.data) - 64;
+        for (uint64_t b = 0; ok && b < e.blocks; ++b) {
+            const uint64_t width = anchors[2 * b + 1] >> 56u;
+            const uint64_t pos = anchors[2 * b + 1] & ((1ull << 56u) - 1);
+            const uint64_t deltas = std::min<uint64_t>(blockSize, e.count - b * blockSize) - 1;
+            ok = width < 64 && pos <= available && deltas * width <= available - pos;
+        }
+    }
+    if (!ok) { Close(); }
+    return ok;
+}
+
+/**
+ * Закрывает файл каталога, после чего каталог пуст.
+ */
+void Catalog::Close() noexcept {
+    if (base) { munmap(const_cast<unsigned char *>(base), length); }
+    base = nullptr;
+    length = 0;
+    index = nullptr;
+}
+
+/**
+ * @return открыт ли файл каталога.
+ */
+[[nodiscard]]
+bool Catalog::IsOpen() const noexcept {
+    return base != nullptr;
+}
+
+/**
+ * @param[in] degree степень многочленов.
+ * @return раздел степени degree, nullptr если каталог пуст или степень не от 1 до 63.
+ */
+[[nodiscard]]
+const Catalog::Entry *Catalog::entry(const uint_fast8_t degree) const noexcept {
+    return index && degree >= 1 && degree < 64 ? index + degree : nullptr;
+}
+
+/**
+ * Восстанавливает k-е значение раздела: первое значение блока
+ * плюс не более blockSize - 1 разностей.
+ * @param[in] e раздел.
+ * @param[in] k номер значения, меньше e.count.
+ * @return k-й многочлен без старшего коэффициента.
+ */
+[[nodiscard]]
+uint_fast64_t Catalog::value(const Entry &e, const uint_fast64_t k) const noexcept {
+    const auto *anchors = reinterpret_cast<const uint64_t *>(base + e.anchors);
+    const auto *data = reinterpret_cast<const uint64_t *>(base + e.data);
+    const uint_fast64_t b = k / blockSize;
+    const uint_fast8_t width = anchors[2 * b + 1] >> 56u;
+    uint_fast64_t pos = anchors[2 * b + 1] & ((1ull << 56u) - 1);
+    uint_fast64_t res = anchors[2 * b];
+    for (uint_fast64_t i = k % blockSize; i > 0; --i, pos += width) {
+        res += bits(data, pos, width) + 1;
+    }
+    return res;
+}
+
+/**
+ * @param[in] degree степень многочленов.
+ * @return записаны ли в каталог все неприводимые многочлены степени degree.
+ */
+[[nodiscard]]
+bool Catalog::IsComplete(const uint_fast8_t degree) const noexcept {
+    const Entry *e = entry(degree);
+    return e && e->complete;
+}
+
+/**
+ * @param[in] degree степень многочленов.
+ * @return число записанных в каталог неприводимых многочленов степени degree,
+ * равное числу всех неприводимых многочленов, если степень записана полностью.
+ */
+[[nodiscard]]
+uint_fast64_t Catalog::Count(const uint_fast8_t degree) const noexcept {
+    const Entry *e = entry(degree);
+    return e ? e->count : 0;
+}
+
+/**
+ * Находит k-й по возрастанию записанный многочлен степени degree за O(1):
+ * номер блока известен сразу, внутри блока суммируется не более
+ * blockSize - 1 разностей.
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @param[in] k номер многочлена, от 0 до Count(degree) - 1.
+ * @return многочлен, 0 если такого нет.
+ */
+[[nodiscard]]
+uint_fast64_t Catalog::Select(const uint_fast8_t degree, const uint_fast64_t k) const noexcept {
+    const Entry *e = entry(degree);
+    if (!e || k >= e->count) { return 0; }
+    return value(*e, k) | (1ull << degree);
+}
+
+/**
+ * Определяет число записанных многочленов степени degree, меньших p.
+ * Старшие биты p указывают (через hints) на блоки, в которых он может
+ * лежать; их в среднем один, т.к. неприводимые многочлены распределены
+ * почти равномерно, поэтому ожидаемое время O(1).
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] p многочлен.
+ * @return номер, который имел бы p среди записанных многочленов.
+ */
+[[nodiscard]]
+uint_fast64_t Catalog::Rank(const uint_fast8_t degree, const uint_fast64_t p) const noexcept {
+    const Entry *e = entry(degree);
+    if (!e || e->count == 0 || p < (1ull << degree)) { return 0; }
+    if (p >> degree > 1) { return e->count; }
+    const uint_fast64_t v = p ^ (1ull << degree);
+    const auto *anchors = reinterpret_cast<const uint64_t *>(base + e->anchors);
+    const auto *hints = reinterpret_cast<const uint32_t *>(base + e->hints);
+    const uint_fast64_t t = v >> (degree - e->hintBits);
+    uint_fast64_t b = hints[t];
+    while (b < hints[t + 1] && anchors[2 * b] <= v) { ++b; }
+    if (b == 0) { return 0; }
+
+    // в блоке b - 1 первое значение не больше v, в блоке b - больше
+    const auto *data = reinterpret_cast<const uint64_t *>(base + e->data);
+    const uint_fast8_t width = anchors[2 * b - 1] >> 56u;
+    uint_fast64_t pos = anchors[2 * b - 1] & ((1ull << 56u) - 1);
+    uint_fast64_t k = (b - 1) * blockSize, x = anchors[2 * b - 2];
+    while (x < v) {
+        if (++k == e->count || k % blockSize == 0) { break; }
+        x += bits(data, pos, width) + 1;
+        pos += width;
+    }
+    return k;
+}
+
+/**
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @param[in] p многочлен.
+ * @return записан ли p в каталог (для полностью записанных степеней -
+ * является ли он неприводимым многочленом степени degree).
+ */
+[[nodiscard]]
+bool Catalog::Contains(const uint_fast8_t degree, const uint_fast64_t p) const noexcept {
+    const uint_fast64_t k = Rank(degree, p);
+    return k < Count(degree) && Select(degree, k) == p;
+}
+
+/**
+ * Выбирает равновероятно один из записанных многочленов степени degree за O(1).
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @param[in,out] rng генератор случайных чисел.
+ * @return многочлен, 0 если многочленов такой степени в каталоге нет.
+ */
+[[nodiscard]]
+uint_fast64_t Catalog::Sample(const uint_fast8_t degree, Xoshiro &rng) const noexcept {
+    const uint_fast64_t n = Count(degree);
+    if (n == 0) { return 0; }
+    return Select(degree, static_cast<uint_fast64_t>((static_cast<unsigned __int128>(rng.Next()) * n) >> 64u));
+}
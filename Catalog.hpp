@@ -0,0 +1,81 @@
+/**
+ * @file    Catalog.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_CATALOG_HPP
+#define BERLEKAMP_CATALOG_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Xoshiro.hpp"
+
+class Catalog {
+    /// число многочленов в блоке: опорное значение и blockSize - 1 разностей
+    static constexpr std::size_t blockSize = 64;
+
+    struct Header;
+    struct Entry;
+
+    const unsigned char *base;
+    std::size_t length;
+    const Entry *index;
+
+    static
+    void encode(std::vector<uint64_t> &, const std::vector<uint_fast64_t> &,
+                uint_fast8_t, uint64_t, Entry &) noexcept;
+
+    [[nodiscard]]
+    const Entry *entry(uint_fast8_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t value(const Entry &, uint_fast64_t) const noexcept;
+
+public:
+    Catalog() noexcept;
+
+    explicit
+    Catalog(const char *) noexcept;
+
+    Catalog(const Catalog &) = delete;
+
+    Catalog &operator=(const Catalog &) = delete;
+
+    ~Catalog() noexcept;
+
+    [[nodiscard]]
+    bool Open(const char *) noexcept;
+
+    void Close() noexcept;
+
+    [[nodiscard]]
+    bool IsOpen() const noexcept;
+
+    [[nodiscard]]
+    bool IsComplete(uint_fast8_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Count(uint_fast8_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Select(uint_fast8_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Rank(uint_fast8_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    bool Contains(uint_fast8_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Sample(uint_fast8_t, Xoshiro &) const noexcept;
+
+    [[nodiscard]] static
+    bool Build(const char *, uint_fast8_t, uint_fast8_t, std::size_t, uint_fast8_t = 0) noexcept;
+};
+
+#endif //BERLEKAMP_CATALOG_HPP
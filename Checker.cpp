@@ -8,68 +8,85 @@
  */
 
 #include "Checker.hpp"
+#include "Stats.hpp"
 
 /**
- * Инициализирует новый объекта-проверщик, используемый для
- * распараллеливания проверки многочленов на неприводимость.
- * @param[in] mutex мьютекс, относящийся к cond.
- * @param[in] cond используется для сигнализирования об окончании работы.
+ * Инициализирует новый объект-проверщик, используемый одним рабочим потоком
+ * генератора. Проверщик владеет буфером под матрицу Берлекампа максимального
+ * размера, поэтому память выделяется один раз на всё время жизни потока.
  */
-Checker::Checker(pthread_mutex_t *mutex, pthread_cond_t *cond) noexcept :
-        poly(0), deg(0), mutex(mutex), cond(cond), notDone(false), irr(false) {}
+Checker::Checker() noexcept : matrix(63), bound(8), tested(0), rejected(0) {}
 
 /**
- * @param p многочлен для проверки на неприводимость.
- * @param degree степень многочлена p, от 1 до 63,
- * не проверяется корректность для уменьшания числа выполняемых операций.
+ * Задаёт наибольшую степень делителей, проверяемых до основного алгоритма
+ * (см. Polynomial::HasSmallFactor), и сбрасывает счётчики отбраковки.
+ * @param b наибольшая степень делителя, от 0 до 8, 0 отключает отбраковку.
  */
-void Checker::Set(const uint_fast64_t p, const uint_fast8_t degree) noexcept {
-    poly = Polynomial(p);
-    deg = degree;
-    irr = false;
-    notDone = true;
+void Checker::SetPrefilter(const uint_fast8_t b) noexcept {
+    bound = b;
+    tested = rejected = 0;
 }
 
 /**
- * Используется для выполнения проверки на неприводимость в отдельном потоке pthread.
- * @param arg экземпляр Checker с установленным для проверки многочленом.
- * @return никакое значение не возвращается, т.к. выполнение функции,
- * как и работа текущего потока, прекращается вызовом pthread_exit.
+ * Первая ступень проверки: отбраковка многочленов с делителями малой степени.
+ * Счётчики принадлежат проверщику, т.е. одному рабочему потоку,
+ * поэтому обновляются без синхронизации.
+ * @param p многочлен для проверки.
+ * @param degree степень многочлена p, от 1 до 63.
+ * @return найден ли у многочлена делитель малой степени (т.е. он приводим).
  */
-void *Checker::Check(void *arg) noexcept {
-    auto *c = static_cast<Checker *>(arg);
-
-    c->irr = c->poly.IsIrredusible(c->deg);
-
-    pthread_mutex_lock(c->mutex);
-    pthread_cond_signal(c->cond);
-    pthread_mutex_unlock(c->mutex);
-
-    c->notDone = false;
+[[nodiscard]]
+bool Checker::Reject(const uint_fast64_t p, const uint_fast8_t degree) noexcept {
+    if (bound == 0) { return false; }
+    ++tested;
+    STATS_CLOCK(t);
+    const bool res = Polynomial(p).HasSmallFactor(degree, bound);
+    STATS_LAP(t, Prefilter, degree, 1, res);
+    rejected += res;
+    return res;
+}
 
-    pthread_exit(nullptr);
+/**
+ * @return наибольшая степень делителей, проверяемых отбраковкой, 0 - отключена.
+ */
+[[nodiscard]]
+uint_fast8_t Checker::Bound() const noexcept {
+    return bound;
 }
 
 /**
- * @return многочлен, для которого выполнялась проверка на неприводимость.
+ * @return число многочленов, прошедших через отбраковку.
  */
 [[nodiscard]]
-uint_fast64_t Checker::Get() const noexcept {
-    return poly.Get();
+uint_fast64_t Checker::Tested() const noexcept {
+    return tested;
 }
 
 /**
- * @return закончена ли проверка на неприводимость.
+ * @return число многочленов, отброшенных отбраковкой.
  */
 [[nodiscard]]
-bool Checker::IsNotDone() const noexcept {
-    return notDone;
+uint_fast64_t Checker::Rejected() const noexcept {
+    return rejected;
 }
 
 /**
- * @return неприводим ли многочлен, для которого была выполнена проверка.
+ * Проверка выполняется в две ступени: сначала отбраковка по делителям
+ * малой степени (см. Reject), затем выбранный алгоритм.
+ * После отбраковки по умолчанию (Auto) используется алгоритм Берлекампа:
+ * у оставшихся многочленов нет делителей степени до 8, поэтому шаги
+ * Бен-Ора их не отбрасывают, и алгоритм Рабина в 2 раза медленнее
+ * (по замерам на степенях 56-63).
+ * @param p многочлен для проверки на неприводимость.
+ * @param degree степень многочлена p, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param method алгоритм проверки.
+ * @return неприводим ли многочлен p.
  */
 [[nodiscard]]
-bool Checker::IsIrreducible() const noexcept {
-    return irr;
+bool Checker::Check(
+        const uint_fast64_t p, const uint_fast8_t degree, Polynomial<>::Method method
+) noexcept {
+    if (method == Polynomial<>::Method::Auto && bound) { method = Polynomial<>::Method::Berlekamp; }
+    return !Reject(p, degree) && Polynomial(p).IsIrredusible(degree, matrix.data(), method);
 }
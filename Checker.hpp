@@ -10,36 +10,36 @@
 #ifndef BERLEKAMP_CHECKER_HPP
 #define BERLEKAMP_CHECKER_HPP
 
-#include <pthread.h>
+#include <cstdint>
+#include <vector>
 #include "Polynomial.hpp"
 
 class Checker {
-    Polynomial poly;
-    uint_fast8_t deg;
-
-    pthread_mutex_t *mutex;
-    pthread_cond_t *cond;
-
-    bool notDone;
-    bool irr;
+    std::vector<uint_fast64_t> matrix;
+    uint_fast8_t bound;
+    uint_fast64_t tested;
+    uint_fast64_t rejected;
 
 public:
-    explicit
-    Checker(pthread_mutex_t *, pthread_cond_t *) noexcept;
+    Checker() noexcept;
 
-    void Set(uint_fast64_t, uint_fast8_t) noexcept;
+    void SetPrefilter(uint_fast8_t) noexcept;
 
-    static
-    void *Check(void *arg) noexcept;
+    [[nodiscard]]
+    bool Reject(uint_fast64_t, uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast8_t Bound() const noexcept;
 
     [[nodiscard]]
-    uint_fast64_t Get() const noexcept;
+    uint_fast64_t Tested() const noexcept;
 
     [[nodiscard]]
-    bool IsNotDone() const noexcept;
+    uint_fast64_t Rejected() const noexcept;
 
     [[nodiscard]]
-    bool IsIrreducible() const noexcept;
+    bool Check(uint_fast64_t, uint_fast8_t,
+               Polynomial<>::Method = Polynomial<>::Method::Auto) noexcept;
 };
 
 #endif //BERLEKAMP_CHECKER_HPP
@@ -0,0 +1,230 @@
+/**
+ * @file    Clmul.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include "Clmul.hpp"
+
+#if defined(__x86_64__)
+#include <wmmintrin.h>
+#define CLMUL_X86
+#endif
+
+/**
+ * Произведение многочленов без аппаратной поддержки: второй множитель
+ * обрабатывается по 4 бита, произведения первого множителя на все
+ * многочлены степени меньше 4 вычисляются заранее.
+ * @param[in] a первый множитель.
+ * @param[in] b второй множитель.
+ * @return произведение a * b над полем GF[2], до 127 степени.
+ */
+[[nodiscard]] static
+unsigned __int128 productSw(const uint_fast64_t a, const uint_fast64_t b) noexcept {
+    unsigned __int128 table[16];
+    table[0] = 0;
+    for (uint_fast8_t k = 1; k < 16; ++k) {
+        table[k] = (k & 1u) ? static_cast<unsigned __int128>(a) ^ (table[k & ~1u])
+                            : table[k >> 1u] << 1u;
+    }
+    unsigned __int128 res = 0;
+    for (int_fast8_t i = 60; i >= 0; i -= 4) {
+        res = (res << 4u) ^ table[(b >> static_cast<uint_fast8_t>(i)) & 0xFu];
+    }
+    return res;
+}
+
+/**
+ * Приводит многочлен по модулю побитово, начиная со старших коэффициентов.
+ * @param[in] c многочлен степени меньше 2 * degree.
+ * @param[in] f модуль.
+ * @param[in] degree степень модуля, от 1 до 63.
+ * @return c (mod f).
+ */
+[[nodiscard]] static
+uint_fast64_t reduceSw(
+        unsigned __int128 c, const uint_fast64_t f, const uint_fast8_t degree
+) noexcept {
+    for (uint_fast8_t i = 2 * degree - 1; i >= degree; --i) {
+        if (static_cast<uint_fast64_t>(c >> i) & 1ull) {
+            c ^= static_cast<unsigned __int128>(f) << static_cast<uint_fast8_t>(i - degree);
+        }
+    }
+    return static_cast<uint_fast64_t>(c);
+}
+
+/**
+ * Умножает два многочлена по модулю третьего по схеме Горнера:
+ * старшие коэффициенты второго множителя обрабатываются первыми,
+ * на каждом шаге результат домножается на x и сразу приводится по модулю.
+ * @param[in] a первый множитель, степени меньше degree.
+ * @param[in] b второй множитель, степени меньше degree.
+ * @param[in] f модуль.
+ * @param[in] degree степень модуля, от 1 до 63.
+ * @return a * b (mod f).
+ */
+[[nodiscard]] static
+uint_fast64_t mulSw(
+        const uint_fast64_t a, const uint_fast64_t b,
+        const uint_fast64_t f, const uint_fast8_t degree
+) noexcept {
+    uint_fast64_t res = 0;
+    for (uint_fast8_t i = degree; i-- > 0;) {
+        res <<= 1ull;
+        res ^= (res >> degree) ? f : 0; // x^degree == f - x^degree (mod f)
+        res ^= ((b >> i) & 1ull) ? a : 0;
+    }
+    return res;
+}
+
+#ifdef CLMUL_X86
+
+/**
+ * Произведение многочленов командой PCLMULQDQ.
+ * @param[in] a первый множитель.
+ * @param[in] b второй множитель.
+ * @return произведение a * b над полем GF[2], до 127 степени.
+ */
+[[nodiscard]] static __attribute__((target("pclmul")))
+unsigned __int128 productHw(const uint_fast64_t a, const uint_fast64_t b) noexcept {
+    const __m128i r = _mm_clmulepi64_si128(
+            _mm_cvtsi64_si128(static_cast<long long>(a)),
+            _mm_cvtsi64_si128(static_cast<long long>(b)), 0x00);
+    const auto l = static_cast<uint64_t>(_mm_cvtsi128_si64(r));
+    const auto h = static_cast<uint64_t>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(r, r)));
+    return (static_cast<unsigned __int128>(h) << 64u) | l;
+}
+
+/**
+ * Приведение по модулю методом Барретта: частное от деления c на f
+ * равно старшим коэффициентам произведения (c / x^n) * mu, где
+ * mu = x^(2n) / f, поэтому вместо деления выполняется два умножения.
+ * Над полем GF[2] результат точный и не требует коррекции.
+ * @param[in] c многочлен степени меньше 2 * degree.
+ * @param[in] f модуль.
+ * @param[in] mu частное x^(2 * degree) / f.
+ * @param[in] degree степень модуля, от 1 до 63.
+ * @return c (mod f).
+ */
+[[nodiscard]] static __attribute__((target("pclmul")))
+uint_fast64_t reduceHw(
+        const unsigned __int128 c, const uint_fast64_t f,
+        const uint_fast64_t mu, const uint_fast8_t degree
+) noexcept {
+    const auto q = static_cast<uint_fast64_t>(
+            productHw(static_cast<uint_fast64_t>(c >> degree), mu) >> degree);
+    const auto r = static_cast<uint_fast64_t>(c) ^ static_cast<uint_fast64_t>(productHw(q, f));
+    return r & ((1ull << degree) - 1ull);
+}
+
+/**
+ * @param[in] a первый множитель, степени меньше degree.
+ * @param[in] b второй множитель, степени меньше degree.
+ * @param[in] f модуль.
+ * @param[in] mu частное x^(2 * degree) / f.
+ * @param[in] degree степень модуля, от 1 до 63.
+ * @return a * b (mod f).
+ */
+[[nodiscard]] static __attribute__((target("pclmul")))
+uint_fast64_t mulHw(
+        const uint_fast64_t a, const uint_fast64_t b, const uint_fast64_t f,
+        const uint_fast64_t mu, const uint_fast8_t degree
+) noexcept {
+    return reduceHw(productHw(a, b), f, mu, degree);
+}
+
+#endif
+
+/**
+ * Определяет один раз за время работы программы, поддерживает ли процессор
+ * команду PCLMULQDQ. Если не поддерживает, используются переносимые
+ * реализации умножения и приведения по модулю.
+ * @return используется ли аппаратное умножение без переносов.
+ */
+[[nodiscard]]
+bool Clmul::Hardware() noexcept {
+#ifdef CLMUL_X86
+    static const bool res = __builtin_cpu_supports("pclmul");
+    return res;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Подготавливает умножение по модулю f: вычисляет частное mu = x^(2n) / f,
+ * используемое при приведении по модулю методом Барретта.
+ * @param[in] f модуль.
+ * @param[in] degree степень модуля, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ */
+Clmul::Clmul(const uint_fast64_t f, const uint_fast8_t degree) noexcept :
+        f(f), mu(0), degree(degree) {
+    auto r = static_cast<unsigned __int128>(1u) << static_cast<uint_fast8_t>(2 * degree);
+    for (uint_fast8_t i = 2 * degree; i >= degree; --i) {
+        if (static_cast<uint_fast64_t>(r >> i) & 1ull) {
+            r ^= static_cast<unsigned __int128>(f) << static_cast<uint_fast8_t>(i - degree);
+            mu |= 1ull << static_cast<uint_fast8_t>(i - degree);
+        }
+    }
+}
+
+/**
+ * @param[in] a первый множитель.
+ * @param[in] b второй множитель.
+ * @return произведение a * b над полем GF[2], до 127 степени.
+ */
+[[nodiscard]]
+unsigned __int128 Clmul::Product(const uint_fast64_t a, const uint_fast64_t b) noexcept {
+#ifdef CLMUL_X86
+    if (Hardware()) { return productHw(a, b); }
+#endif
+    return productSw(a, b);
+}
+
+/**
+ * @param[in] c многочлен степени меньше 2n, где n - степень модуля.
+ * @return c по модулю f.
+ */
+[[nodiscard]]
+uint_fast64_t Clmul::Reduce(const unsigned __int128 c) const noexcept {
+#ifdef CLMUL_X86
+    if (Hardware()) { return reduceHw(c, f, mu, degree); }
+#endif
+    return reduceSw(c, f, degree);
+}
+
+/**
+ * @param[in] a первый множитель, степени меньше степени модуля.
+ * @param[in] b второй множитель, степени меньше степени модуля.
+ * @return a * b по модулю f.
+ */
+[[nodiscard]]
+uint_fast64_t Clmul::Mul(const uint_fast64_t a, const uint_fast64_t b) const noexcept {
+#ifdef CLMUL_X86
+    if (Hardware()) { return mulHw(a, b, f, mu, degree); }
+#endif
+    return mulSw(a, b, f, degree);
+}
+
+/**
+ * @param[in] a многочлен степени меньше степени модуля.
+ * @return a^2 по модулю f.
+ */
+[[nodiscard]]
+uint_fast64_t Clmul::Sqr(const uint_fast64_t a) const noexcept {
+    return Mul(a, a);
+}
+
+/**
+ * Частное для приведения методом Барретта, нужно реализациям,
+ * которые умножают сразу несколько пар многочленов (см. Field).
+ * @return частное x^(2n) / f, где n - степень модуля.
+ */
+[[nodiscard]]
+uint_fast64_t Clmul::Mu() const noexcept {
+    return mu;
+}
@@ -0,0 +1,43 @@
+/**
+ * @file    Clmul.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_CLMUL_HPP
+#define BERLEKAMP_CLMUL_HPP
+
+#include <cstdint>
+
+class Clmul {
+    uint_fast64_t f;
+    uint_fast64_t mu;
+    uint_fast8_t degree;
+
+public:
+    explicit
+    Clmul(uint_fast64_t, uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Reduce(unsigned __int128) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Mul(uint_fast64_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Sqr(uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Mu() const noexcept;
+
+    [[nodiscard]] static
+    unsigned __int128 Product(uint_fast64_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    bool Hardware() noexcept;
+};
+
+#endif //BERLEKAMP_CLMUL_HPP
@@ -0,0 +1,274 @@
+/**
+ * @file    Dispatcher.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <random>
+#include <thread>
+
+#include "Dispatcher.hpp"
+
+/**
+ * Создаёт диспетчер и запускает пул рабочих потоков, общий для всех
+ * запросов: число потоков не зависит от числа одновременных запросов.
+ * Генераторы случайных чисел потоков начинают с состояний, продвинутых
+ * на 2^128 шагов друг относительно друга (см. Xoshiro::Jump).
+ * @param[in] threadsNum число рабочих потоков,
+ * 0 - по числу потоков, доступных в системе.
+ */
+Dispatcher::Dispatcher(uint_fast8_t threadsNum) noexcept :
+        mutex(PTHREAD_MUTEX_INITIALIZER), hasWork(PTHREAD_COND_INITIALIZER),
+        earliest(Clock::time_point::max()), lastId(0), cursor(0), stop(false) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        threadsNum = cores > 0 ? cores : 1;
+    }
+    // адреса элементов не должны меняться после запуска потоков,
+    // поэтому все элементы создаются сразу
+    workers = std::vector<Worker>(threadsNum);
+    Xoshiro state{std::random_device()()};
+    for (auto &w : workers) {
+        w.owner = this;
+        w.rng = state;
+        state.Jump();
+    }
+    for (uint_fast8_t i = 0; i < threadsNum; ++i) {
+        if (pthread_create(&workers[i].thread, nullptr, &work, &workers[i])) {
+            workers.resize(i);
+            break;
+        }
+    }
+}
+
+/**
+ * Останавливает пул и дожидается завершения рабочих потоков.
+ * Незавершённые запросы отменяются: их callback вызывается
+ * в текущем потоке со статусом Cancelled.
+ */
+Dispatcher::~Dispatcher() noexcept {
+    pthread_mutex_lock(&mutex);
+    stop = true;
+    pthread_cond_broadcast(&hasWork);
+    pthread_mutex_unlock(&mutex);
+    for (auto &w : workers) { pthread_join(w.thread, nullptr); }
+    for (auto &r : queue) { (void) finish(*r, 0, Status::Cancelled); }
+    pthread_cond_destroy(&hasWork);
+    pthread_mutex_destroy(&mutex);
+}
+
+/**
+ * Завершает запрос, если он ещё не завершён, и вызывает его callback.
+ * Запрос может завершиться одновременно в нескольких потоках (найден
+ * многочлен, истёк срок, отмена), callback вызывается только первым.
+ * @param[in] r запрос.
+ * @param[in] p результат.
+ * @param[in] status чем завершился запрос.
+ * @return завершил ли запрос этот вызов.
+ */
+bool Dispatcher::finish(Request &r, const uint_fast64_t p, const Status status) noexcept {
+    Status expected = Status::Pending;
+    if (!r.status.compare_exchange_strong(expected, status)) { return false; }
+    r.callback(p, status);
+    return true;
+}
+
+/**
+ * Выбирает запрос, которым рабочий поток займётся следующим: запросы
+ * обслуживаются по кругу, по блоку кандидатов за раз, поэтому запросы
+ * разных степеней продвигаются одновременно, и долгий запрос высокой
+ * степени не задерживает остальные. Завершённые запросы убираются
+ * из очереди, запросы с истёкшим сроком переносятся в expired, очередь
+ * просматривается целиком, только когда истекает ближайший срок.
+ * Вызывающий поток должен удерживать мьютекс mutex.
+ * @param[out] expired запросы с истёкшим сроком, их должен завершить
+ * вызывающий поток после освобождения мьютекса.
+ * @return запрос, nullptr если очередь пуста.
+ */
+[[nodiscard]]
+std::shared_ptr<Dispatcher::Request> Dispatcher::next(std::vector<std::shared_ptr<Request>> &expired) noexcept {
+    const auto now = Clock::now();
+    if (now >= earliest) {
+        earliest = Clock::time_point::max();
+        std::size_t k = 0;
+        for (auto &r : queue) {
+            if (r->status.load() != Status::Pending) { continue; }
+            if (r->deadline <= now) {
+                expired.push_back(std::move(r));
+                continue;
+            }
+            earliest = std::min(earliest, r->deadline);
+            queue[k++] = std::move(r);
+        }
+        queue.resize(k);
+    }
+    while (!queue.empty()) {
+        if (cursor >= queue.size()) { cursor = 0; }
+        if (queue[cursor]->status.load() != Status::Pending) {
+            queue.erase(queue.begin() + cursor);
+            continue;
+        }
+        return queue[cursor++];
+    }
+    return nullptr;
+}
+
+/**
+ * Проверяет для запроса очередной блок из blockSize случайных кандидатов
+ * (младший и старший коэффициенты всегда единицы) проверщиком потока
+ * (см. Checker::Check). Перед каждым кандидатом проверяется, не завершён ли
+ * запрос, поэтому после отмены поток оставляет его, не дожидаясь конца
+ * блока, а срок проверяется при каждом выборе запроса (см. next).
+ * @param[in,out] w рабочий поток.
+ * @param[in,out] r запрос.
+ */
+void Dispatcher::search(Worker &w, Request &r) noexcept {
+    const uint_fast8_t d = r.degree;
+    if (d == 1) {
+        // x и x+1 неприводимы, выбираем случайно
+        (void) finish(r, 2ull | (w.rng.Next() >> 63u), Status::Done);
+        return;
+    }
+    for (std::size_t k = 0; k < blockSize; ++k) {
+        if (r.status.load(std::memory_order_relaxed) != Status::Pending) { return; }
+        const uint_fast64_t p = (1ull << d) | (w.rng.Next() >> (65u - d) << 1u) | 1ull;
+        if (w.checker.Check(p, d)) {
+            (void) finish(r, p, Status::Done);
+            return;
+        }
+    }
+}
+
+/**
+ * Цикл рабочего потока: выбирает запрос (см. next), завершает запросы
+ * с истёкшим сроком и проверяет для выбранного запроса блок кандидатов.
+ * Если запросов нет, поток спит до появления нового запроса.
+ * @param arg экземпляр Worker, принадлежащий данному потоку.
+ * @return nullptr после остановки диспетчера.
+ */
+void *Dispatcher::work(void *arg) noexcept {
+    auto &w = *static_cast<Worker *>(arg);
+    auto &owner = *w.owner;
+    std::vector<std::shared_ptr<Request>> expired;
+    std::shared_ptr<Request> r;
+    while (true) {
+        pthread_mutex_lock(&owner.mutex);
+        while (!owner.stop && !(r = owner.next(expired)) && expired.empty()) {
+            pthread_cond_wait(&owner.hasWork, &owner.mutex);
+        }
+        const bool stopped = owner.stop;
+        pthread_mutex_unlock(&owner.mutex);
+        for (auto &e : expired) { (void) finish(*e, 0, Status::Expired); }
+        expired.clear();
+        if (stopped) { break; }
+        if (r) { owner.search(w, *r); }
+        r.reset();
+    }
+    return nullptr;
+}
+
+/**
+ * Ставит в очередь запрос неприводимого многочлена и сразу возвращает
+ * управление. Результат передаётся в callback, который вызывается ровно
+ * один раз: в рабочем потоке со статусом Done и найденным многочленом или
+ * со статусом Expired и 0, если многочлен не найден до deadline; в потоке,
+ * вызвавшем Cancel (или деструктор), со статусом Cancelled и 0; в текущем
+ * потоке со статусом Rejected, если запрос не принят. callback выполняется
+ * в рабочем потоке вместо поиска, поэтому должен быть коротким.
+ * @param[in] degree степень многочлена в пределах от 1 до 63,
+ * проверка попадания в эти границы выполняется.
+ * @param[in] deadline срок, после которого поиск прекращается,
+ * Clock::time_point::max() - без срока.
+ * @param[in] callback получает результат и статус запроса.
+ * @return номер запроса для Cancel, 0 если запрос не принят: degree
+ * задан некорректно (результат 0) или не удалось запустить ни одного
+ * рабочего потока (результат 1).
+ */
+uint_fast64_t Dispatcher::Submit(
+        const uint_fast8_t degree, const Clock::time_point deadline, Callback callback
+) noexcept {
+    if (degree == 0 || degree > 63 || workers.empty()) {
+        callback(degree == 0 || degree > 63 ? 0 : 1, Status::Rejected);
+        return 0;
+    }
+    auto r = std::make_shared<Request>();
+    r->deadline = deadline;
+    r->callback = std::move(callback);
+    r->status.store(Status::Pending, std::memory_order_relaxed);
+    r->degree = degree;
+    pthread_mutex_lock(&mutex);
+    r->id = ++lastId;
+    queue.push_back(r);
+    earliest = std::min(earliest, deadline);
+    pthread_cond_broadcast(&hasWork);
+    pthread_mutex_unlock(&mutex);
+    return r->id;
+}
+
+/**
+ * Асинхронный вариант Generator::GetIrrPoly: ставит запрос в очередь
+ * (см. Submit) и возвращает future с результатом.
+ * @param[in] degree степень многочлена в пределах от 1 до 63.
+ * @param[in] timeout наибольшее время поиска, 0 - без ограничения.
+ * @param[out] id если задан, получает номер запроса для Cancel
+ * (0 если запрос не принят).
+ * @return future с неприводимым многочленом требуемой степени, 0 если
+ * degree задан некорректно, срок истёк или запрос отменён, 1 если
+ * не удалось запустить ни одного рабочего потока.
+ */
+[[nodiscard]]
+std::future<uint_fast64_t> Dispatcher::GetIrrPoly(
+        const uint_fast8_t degree, const Clock::duration timeout, uint_fast64_t *const id
+) noexcept {
+    auto promise = std::make_shared<std::promise<uint_fast64_t>>();
+    auto res = promise->get_future();
+    const auto deadline = timeout > Clock::duration::zero() ? Clock::now() + timeout : Clock::time_point::max();
+    const uint_fast64_t n = Submit(degree, deadline, [promise](const uint_fast64_t p, Status) {
+        promise->set_value(p);
+    });
+    if (id) { *id = n; }
+    return res;
+}
+
+/**
+ * Отменяет запрос: рабочие потоки оставляют его перед проверкой
+ * очередного кандидата, а callback вызывается в текущем потоке
+ * со статусом Cancelled.
+ * @param[in] id номер запроса (см. Submit).
+ * @return отменён ли запрос, false если он уже завершён или не найден.
+ */
+bool Dispatcher::Cancel(const uint_fast64_t id) noexcept {
+    std::shared_ptr<Request> r;
+    pthread_mutex_lock(&mutex);
+    // номера запросов в очереди возрастают
+    const auto it = std::lower_bound(queue.begin(), queue.end(), id,
+                                     [](const std::shared_ptr<Request> &q, const uint_fast64_t v) { return q->id < v; });
+    if (it != queue.end() && (*it)->id == id) { r = *it; }
+    pthread_mutex_unlock(&mutex);
+    return r && finish(*r, 0, Status::Cancelled);
+}
+
+/**
+ * @return число незавершённых запросов.
+ */
+[[nodiscard]]
+std::size_t Dispatcher::Pending() noexcept {
+    pthread_mutex_lock(&mutex);
+    const auto res = static_cast<std::size_t>(std::count_if(queue.begin(), queue.end(), [](const auto &r) {
+        return r->status.load() == Status::Pending;
+    }));
+    pthread_mutex_unlock(&mutex);
+    return res;
+}
+
+/**
+ * @return число запущенных рабочих потоков.
+ */
+[[nodiscard]]
+std::size_t Dispatcher::Threads() const noexcept {
+    return workers.size();
+}
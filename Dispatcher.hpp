@@ -0,0 +1,106 @@
+/**
+ * @file    Dispatcher.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_DISPATCHER_HPP
+#define BERLEKAMP_DISPATCHER_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <vector>
+#include <pthread.h>
+#include "Checker.hpp"
+#include "Xoshiro.hpp"
+
+class Dispatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// чем завершился запрос
+    enum class Status : uint_fast8_t {
+        Pending,
+        Done,
+        Expired,
+        Cancelled,
+        Rejected
+    };
+
+    using Callback = std::function<void(uint_fast64_t, Status)>;
+
+private:
+    /// число кандидатов, проверяемых потоком между выборами запроса
+    static constexpr std::size_t blockSize = 16;
+
+    struct Request {
+        uint_fast64_t id;
+        Clock::time_point deadline;
+        Callback callback;
+        std::atomic<Status> status;
+        uint_fast8_t degree;
+    };
+
+    struct Worker {
+        Dispatcher *owner;
+        Checker checker;
+        Xoshiro rng;
+        pthread_t thread;
+    };
+
+    std::vector<Worker> workers;
+    std::vector<std::shared_ptr<Request>> queue;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t hasWork;
+
+    Clock::time_point earliest;
+    uint_fast64_t lastId;
+    std::size_t cursor;
+    bool stop;
+
+    static
+    void *work(void *) noexcept;
+
+    [[nodiscard]]
+    std::shared_ptr<Request> next(std::vector<std::shared_ptr<Request>> &) noexcept;
+
+    void search(Worker &, Request &) noexcept;
+
+    static
+    bool finish(Request &, uint_fast64_t, Status) noexcept;
+
+public:
+    explicit
+    Dispatcher(uint_fast8_t = 0) noexcept;
+
+    Dispatcher(const Dispatcher &) = delete;
+
+    Dispatcher &operator=(const Dispatcher &) = delete;
+
+    ~Dispatcher() noexcept;
+
+    uint_fast64_t Submit(uint_fast8_t, Clock::time_point, Callback) noexcept;
+
+    [[nodiscard]]
+    std::future<uint_fast64_t> GetIrrPoly(uint_fast8_t, Clock::duration = Clock::duration::zero(),
+                                          uint_fast64_t * = nullptr) noexcept;
+
+    bool Cancel(uint_fast64_t) noexcept;
+
+    [[nodiscard]]
+    std::size_t Pending() noexcept;
+
+    [[nodiscard]]
+    std::size_t Threads() const noexcept;
+};
+
+#endif //BERLEKAMP_DISPATCHER_HPP
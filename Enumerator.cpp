@@ -0,0 +1,264 @@
+/**
+ * @file    Enumerator.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <thread>
+
+#include "Batch.hpp"
+#include "Enumerator.hpp"
+
+/**
+ * Число кандидатов, которое рабочий поток забирает из своего диапазона за раз.
+ */
+static const uint_fast64_t chunk = 1024;
+
+/**
+ * Число найденных многочленов, накапливаемых рабочим потоком перед выдачей.
+ */
+static const std::size_t batch = 4096;
+
+/**
+ * Создаёт объект для полного перебора многочленов заданной степени.
+ * @param[in] threadsNum число потоков, используемых при переборе,
+ * 0 - по числу потоков, доступных в системе.
+ */
+Enumerator::Enumerator(uint_fast8_t threadsNum) noexcept :
+        output(PTHREAD_MUTEX_INITIALIZER), callback(nullptr),
+        degree(0), threadsNum(threadsNum) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        this->threadsNum = cores > 0 ? cores : 1;
+    }
+}
+
+/**
+ * Забирает очередную порцию кандидатов из собственного диапазона потока.
+ * @param[in,out] w рабочий поток.
+ * @param[out] b начало порции.
+ * @param[out] e конец порции (не включительно).
+ * @return удалось ли забрать непустую порцию.
+ */
+[[nodiscard]]
+bool Enumerator::take(Worker &w, uint_fast64_t &b, uint_fast64_t &e) noexcept {
+    pthread_mutex_lock(&w.mutex);
+    b = w.begin;
+    e = w.end - w.begin > chunk ? w.begin + chunk : w.end;
+    w.begin = e;
+    pthread_mutex_unlock(&w.mutex);
+    return b != e;
+}
+
+/**
+ * Забирает себе старшую половину диапазона у потока, которому осталось
+ * проверить больше всего кандидатов.
+ * @param[in,out] w рабочий поток, у которого закончились кандидаты.
+ * @return удалось ли найти работу, false - перебор закончен.
+ */
+[[nodiscard]]
+bool Enumerator::steal(Worker &w) noexcept {
+    while (true) {
+        Worker *victim = nullptr;
+        uint_fast64_t most = 0, rest;
+        for (auto &v : workers) {
+            if (&v == &w) { continue; }
+            pthread_mutex_lock(&v.mutex);
+            rest = v.end - v.begin;
+            pthread_mutex_unlock(&v.mutex);
+            if (rest > most) {
+                most = rest;
+                victim = &v;
+            }
+        }
+        if (victim == nullptr) { return false; }
+
+        pthread_mutex_lock(&victim->mutex);
+        rest = victim->end - victim->begin;
+        if (rest == 0) {
+            // пока мы искали, диапазон уже разобрали
+            pthread_mutex_unlock(&victim->mutex);
+            continue;
+        }
+        const uint_fast64_t mid = victim->begin + rest / 2;
+        pthread_mutex_lock(&w.mutex);
+        w.begin = mid;
+        w.end = victim->end;
+        pthread_mutex_unlock(&w.mutex);
+        victim->end = mid;
+        pthread_mutex_unlock(&victim->mutex);
+        return true;
+    }
+}
+
+/**
+ * Передаёт накопленные потоком многочлены в callback.
+ * Вызовы callback из разных потоков не пересекаются во времени.
+ * @param[in,out] w рабочий поток.
+ */
+void Enumerator::flush(Worker &w) noexcept {
+    if (w.out.empty()) { return; }
+    pthread_mutex_lock(&output);
+    for (auto p : w.out) { (*callback)(p); }
+    pthread_mutex_unlock(&output);
+    w.out.clear();
+}
+
+/**
+ * Цикл рабочего потока: проверяет кандидатов из своего диапазона,
+ * а когда он заканчивается, забирает часть диапазона другого потока.
+ * Из каждой пары взаимно отражённых многочленов проверяется только меньший.
+ * Кандидаты из порции проверяются вместе (см. Batch::Check).
+ * @param arg экземпляр Worker, принадлежащий данному потоку.
+ * @return nullptr после окончания перебора.
+ */
+void *Enumerator::work(void *arg) noexcept {
+    auto &w = *static_cast<Worker *>(arg);
+    auto &e = *w.owner;
+    const uint_fast8_t n = e.degree;
+    uint_fast64_t b, end, p, r;
+    uint_fast64_t polys[chunk];
+    bool irr[chunk];
+    std::size_t k, i;
+
+    while (e.take(w, b, end) || (e.steal(w) && e.take(w, b, end))) {
+        for (k = 0; b < end; ++b) {
+            p = (1ull << n) | (b << 1ull) | 1ull;
+            if (p <= Polynomial(p).Reverse(n)) { polys[k++] = p; }
+        }
+        Batch::Check(polys, irr, k, n);
+        for (i = 0; i < k; ++i) {
+            if (!irr[i]) { continue; }
+            p = polys[i];
+            r = Polynomial(p).Reverse(n);
+            w.count += p == r ? 1 : 2;
+            if (e.callback == nullptr) { continue; }
+            w.out.push_back(p);
+            if (p != r) { w.out.push_back(r); }
+            if (w.out.size() >= batch) { e.flush(w); }
+        }
+    }
+    if (e.callback != nullptr) { e.flush(w); }
+    return nullptr;
+}
+
+/**
+ * Выполняет перебор многочленов степени d с ненулевым свободным членом,
+ * кандидат номер b - многочлен x^d + 2b + 1, всего кандидатов 2^(d-1).
+ * Диапазон кандидатов изначально делится поровну между потоками,
+ * освободившиеся потоки забирают работу у занятых. Вызывающий поток
+ * также участвует в переборе.
+ * @param[in] d степень многочленов, от 1 до 63.
+ * @param[in] first номер первого кандидата.
+ * @param[in] last номер последнего кандидата (не включительно),
+ * ограничивается числом кандидатов.
+ * @param[in] cb получает найденные многочлены, nullptr - только подсчёт.
+ * @return число неприводимых многочленов, найденных в диапазоне.
+ */
+[[nodiscard]]
+uint_fast64_t Enumerator::run(
+        const uint_fast8_t d, const uint_fast64_t first, uint_fast64_t last,
+        const std::function<void(uint_fast64_t)> *const cb
+) noexcept {
+    if (d == 0 || d > 63) { return 0; }
+    last = std::min<uint_fast64_t>(last, 1ull << (d - 1u));
+    if (first >= last) { return 0; }
+    degree = d;
+    callback = cb;
+
+    const uint_fast64_t total = last - first;
+    const uint_fast64_t part = total / threadsNum, extra = total % threadsNum;
+    workers.clear();
+    workers.reserve(threadsNum);
+    for (uint_fast8_t i = 0; i < threadsNum; ++i) {
+        const uint_fast64_t begin = first + part * i + (i < extra ? i : extra);
+        workers.push_back(Worker{this, pthread_t(), PTHREAD_MUTEX_INITIALIZER,
+                                 begin, begin + part + (i < extra), 0, {}});
+    }
+    // если поток не удалось создать, его диапазон разберут остальные
+    std::vector<bool> started(threadsNum, false);
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        started[i] = pthread_create(&workers[i].thread, nullptr, &work, &workers[i]) == 0;
+    }
+    work(&workers[0]);
+
+    uint_fast64_t res = workers[0].count;
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        if (started[i]) { pthread_join(workers[i].thread, nullptr); }
+        res += workers[i].count;
+    }
+    for (auto &w : workers) { pthread_mutex_destroy(&w.mutex); }
+    workers.clear();
+    callback = nullptr;
+    return res;
+}
+
+/**
+ * Подсчитывает число неприводимых многочленов заданной степени полным перебором.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @return число неприводимых многочленов, 0 если degree задан некорректно.
+ */
+[[nodiscard]]
+uint_fast64_t Enumerator::Count(const uint_fast8_t degree) noexcept {
+    // x не попадает под перебор, т.к. у него нулевой свободный член
+    return degree == 1 ? 2 : run(degree, 0, UINT64_MAX, nullptr);
+}
+
+/**
+ * Подсчитывает неприводимые многочлены среди кандидатов с номерами
+ * от first до last (см. run), например для части перебора, выполняемой
+ * отдельным процессом. Из пары взаимно отражённых многочленов
+ * проверяется меньший, и пара учитывается в том диапазоне, в который
+ * он попадает, поэтому суммы по непересекающимся диапазонам, покрывающим
+ * все 2^(degree-1) кандидатов, равны Count(degree) (для degree = 1 - без x).
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] first номер первого кандидата.
+ * @param[in] last номер последнего кандидата (не включительно).
+ * @return число неприводимых многочленов, 0 если параметры заданы некорректно.
+ */
+[[nodiscard]]
+uint_fast64_t Enumerator::Count(
+        const uint_fast8_t degree, const uint_fast64_t first, const uint_fast64_t last
+) noexcept {
+    return run(degree, first, last, nullptr);
+}
+
+/**
+ * Находит полным перебором все неприводимые многочлены заданной степени.
+ * Многочлены передаются в callback порциями по мере нахождения, в произвольном
+ * порядке; callback вызывается из рабочих потоков, но никогда одновременно.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] callback получает каждый неприводимый многочлен ровно один раз.
+ * @return число неприводимых многочленов, 0 если degree задан некорректно.
+ */
+uint_fast64_t Enumerator::Enumerate(
+        const uint_fast8_t degree, const std::function<void(uint_fast64_t)> &callback
+) noexcept {
+    if (degree == 1) {
+        callback(2ull);
+        callback(3ull);
+        return 2;
+    }
+    return run(degree, 0, UINT64_MAX, &callback);
+}
+
+/**
+ * То же, что и Count(degree, first, last), но найденные многочлены
+ * (и отражённые к ним, даже если те вне диапазона) передаются в callback
+ * так же, как в Enumerate(degree, callback).
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] first номер первого кандидата.
+ * @param[in] last номер последнего кандидата (не включительно).
+ * @param[in] callback получает каждый найденный многочлен.
+ * @return число неприводимых многочленов, 0 если параметры заданы некорректно.
+ */
+uint_fast64_t Enumerator::Enumerate(
+        const uint_fast8_t degree, const uint_fast64_t first, const uint_fast64_t last,
+        const std::function<void(uint_fast64_t)> &callback
+) noexcept {
+    return run(degree, first, last, &callback);
+}
@@ -0,0 +1,66 @@
+/**
+ * @file    Enumerator.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_ENUMERATOR_HPP
+#define BERLEKAMP_ENUMERATOR_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <pthread.h>
+
+class Enumerator {
+    struct Worker {
+        Enumerator *owner;
+        pthread_t thread;
+        pthread_mutex_t mutex;
+        uint_fast64_t begin;
+        uint_fast64_t end;
+        uint_fast64_t count;
+        std::vector<uint_fast64_t> out;
+    };
+
+    std::vector<Worker> workers;
+    pthread_mutex_t output;
+    const std::function<void(uint_fast64_t)> *callback;
+    uint_fast8_t degree;
+    uint_fast8_t threadsNum;
+
+    static
+    void *work(void *) noexcept;
+
+    [[nodiscard]]
+    bool take(Worker &, uint_fast64_t &, uint_fast64_t &) noexcept;
+
+    [[nodiscard]]
+    bool steal(Worker &) noexcept;
+
+    void flush(Worker &) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t run(uint_fast8_t, uint_fast64_t, uint_fast64_t,
+                      const std::function<void(uint_fast64_t)> *) noexcept;
+
+public:
+    explicit
+    Enumerator(uint_fast8_t = 0) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Count(uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Count(uint_fast8_t, uint_fast64_t, uint_fast64_t) noexcept;
+
+    uint_fast64_t Enumerate(uint_fast8_t, const std::function<void(uint_fast64_t)> &) noexcept;
+
+    uint_fast64_t Enumerate(uint_fast8_t, uint_fast64_t, uint_fast64_t,
+                            const std::function<void(uint_fast64_t)> &) noexcept;
+};
+
+#endif //BERLEKAMP_ENUMERATOR_HPP
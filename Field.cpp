@@ -0,0 +1,376 @@
+/**
+ * @file    Field.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include "Polynomial.hpp"
+#include "Field.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define FIELD_X86
+#endif
+
+#ifdef FIELD_X86
+
+/**
+ * Сдвигает вправо 128-битные дорожки вектора.
+ * @param[in] c вектор из четырёх 128-битных многочленов.
+ * @param[in] right n - величина сдвига, от 1 до 63.
+ * @param[in] left 64 - n.
+ * @return вектор, в младшем слове каждой дорожки которого
+ * младшие 64 коэффициента c / x^n.
+ */
+[[nodiscard]] static inline __attribute__((target("avx512f"), always_inline))
+__m512i shift(const __m512i c, const __m128i right, const __m128i left) noexcept {
+    // маскированные формы: немаскированные в GCC 12 дают -Wuninitialized
+    return _mm512_or_si512(_mm512_maskz_srl_epi64(0xFF, c, right),
+                           _mm512_maskz_unpackhi_epi64(0xFF, _mm512_maskz_sll_epi64(0xFF, c, left),
+                                                       _mm512_setzero_si512()));
+}
+
+/**
+ * Умножает элементы поля по восемь командой VPCLMULQDQ: одна команда
+ * перемножает четыре пары, чётные и нечётные элементы перемножаются
+ * отдельно, затем произведения приводятся по модулю методом Барретта
+ * (см. Clmul) так же по четыре, и результаты чередуются обратно.
+ * @param[in] a первые множители.
+ * @param[in] b вторые множители.
+ * @param[in] stride 1 - b массив, 0 - все элементы умножаются на b[0].
+ * @param[out] res произведения, может совпадать с a или b.
+ * @param[in] count число элементов.
+ * @param[in] f модуль.
+ * @param[in] mu частное x^(2n) / f.
+ * @param[in] n степень модуля, от 2 до 63.
+ * @return число перемноженных элементов, кратное 8.
+ */
+[[nodiscard]] static __attribute__((target("avx512f,vpclmulqdq")))
+std::size_t mulWide(
+        const uint_fast64_t *const a, const uint_fast64_t *const b, const std::size_t stride,
+        uint_fast64_t *const res, const std::size_t count,
+        const uint_fast64_t f, const uint_fast64_t mu, const uint_fast8_t n
+) noexcept {
+    const __m512i F = _mm512_set1_epi64(static_cast<long long>(f));
+    const __m512i MU = _mm512_set1_epi64(static_cast<long long>(mu));
+    const __m512i M = _mm512_set1_epi64(static_cast<long long>((1ull << n) - 1ull));
+    const __m128i right = _mm_cvtsi32_si128(n), left = _mm_cvtsi32_si128(64 - n);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512i A = _mm512_loadu_si512(a + i);
+        const __m512i B = stride ? _mm512_loadu_si512(b + i) : _mm512_set1_epi64(static_cast<long long>(*b));
+        __m512i c[2] = {_mm512_clmulepi64_epi128(A, B, 0x00), _mm512_clmulepi64_epi128(A, B, 0x11)};
+        for (auto &v : c) {
+            const __m512i q = _mm512_clmulepi64_epi128(shift(v, right, left), MU, 0x00);
+            v = _mm512_xor_si512(v, _mm512_clmulepi64_epi128(shift(q, right, left), F, 0x00));
+        }
+        _mm512_storeu_si512(res + i, _mm512_and_si512(_mm512_maskz_unpacklo_epi64(0xFF, c[0], c[1]), M));
+    }
+    return i;
+}
+
+#endif
+
+/**
+ * Определяет один раз за время работы программы, поддерживает ли процессор
+ * команды AVX-512 и VPCLMULQDQ.
+ * @return умножаются ли элементы массивов по восемь.
+ */
+[[nodiscard]] static
+bool wide() noexcept {
+#ifdef FIELD_X86
+    static const bool res = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("vpclmulqdq");
+    return res;
+#else
+    return false;
+#endif
+}
+
+/**
+ * Строит поле GF(2^n) как кольцо вычетов по неприводимому многочлену
+ * степени n, например полученному от Generator::GetIrrPoly. Элементы
+ * поля - многочлены степени меньше n, записанные так же, как модуль.
+ * Для n не больше 16 строятся таблицы логарифмов и степеней порождающего
+ * элемента мультипликативной группы (если модуль примитивен, это x,
+ * иначе первый подходящий элемент), и умножение сводится к сложению
+ * логарифмов. Для больших n произведение приводится по модулю методом
+ * Барретта, а если модуль разрежен (не больше 5 членов, и все, кроме
+ * старшего, степени не больше n / 2, как у трёхчленов и пятичленов
+ * из Generator::GetSparsePoly), - двумя свёртками старших коэффициентов
+ * сдвигами. Также вычисляются следы Tr(x^i), через которые след
+ * любого элемента находится одной операцией.
+ * @param[in] f неприводимый многочлен степени от 1 до 63,
+ * неприводимость проверяется: если f приводим, Degree() возвращает 0,
+ * а все операции - 0.
+ */
+Field::Field(const uint_fast64_t f) noexcept :
+        taps{}, clmul(f, f > 1 ? 63u - __builtin_clzll(f) : 1u), modulus(f),
+        mask(0), order(0), trace(0), degree(0), tapsNum(0) {
+    const uint_fast8_t n = f > 1 ? 63u - __builtin_clzll(f) : 0u;
+    if (n == 0 || !Polynomial<>(f).IsIrredusible(n, Polynomial<>::Method::Auto)) { return; }
+    degree = n;
+    mask = order = (1ull << n) - 1ull;
+
+    // бит i - след x^i, Tr(b) = b + b^2 + ... + b^(2^(n-1))
+    for (uint_fast8_t i = 0; i < n; ++i) {
+        uint_fast64_t b = 1ull << i, sum = 0;
+        for (uint_fast8_t k = 0; k < n; ++k, b = clmul.Sqr(b)) { sum ^= b; }
+        trace |= sum << i;
+    }
+
+    if (n <= tableDegree) {
+        logs.assign(order + 1, 0);
+        exps.assign(2 * order, 0);
+        // мультипликативная группа циклическая, порождающих элементов
+        // не меньше половины для всех n до 16, поэтому поиск короткий
+        for (uint_fast64_t g = n == 1 ? 1 : 2;; ++g) {
+            uint_fast64_t a = 1, k = 0;
+            do {
+                exps[k++] = a;
+                a = clmul.Mul(a, g);
+            } while (a != 1);
+            if (k == order) { break; }
+        }
+        for (uint_fast64_t k = 0; k < order; ++k) {
+            logs[exps[k]] = k;
+            exps[k + order] = exps[k];
+        }
+        return;
+    }
+
+    const uint_fast64_t g = f ^ (1ull << n);
+    if (__builtin_popcountll(g) <= 4 && (63u - __builtin_clzll(g)) <= n / 2u) {
+        for (uint_fast64_t t = g; t; t &= t - 1u) { taps[tapsNum++] = __builtin_ctzll(t); }
+    }
+}
+
+/**
+ * Приводит произведение элементов по модулю. Для разреженного модуля
+ * f = x^n + g старшие коэффициенты h * x^n заменяются на h * g,
+ * т.е. на сумму сдвигов h: после первой свёртки степень не больше
+ * n + deg(g) - 2, после второй - меньше n.
+ * @param[in] c многочлен степени меньше 2n.
+ * @return c (mod f).
+ */
+[[nodiscard]]
+uint_fast64_t Field::reduce(const unsigned __int128 c) const noexcept {
+    if (!tapsNum) { return clmul.Reduce(c); }
+    const unsigned __int128 h = c >> degree;
+    unsigned __int128 t = c & mask;
+    for (uint_fast8_t i = 0; i < tapsNum; ++i) { t ^= h << taps[i]; }
+    const auto l = static_cast<uint_fast64_t>(t >> degree);
+    auto res = static_cast<uint_fast64_t>(t) & mask;
+    for (uint_fast8_t i = 0; i < tapsNum; ++i) { res ^= l << taps[i]; }
+    return res;
+}
+
+/**
+ * @param[in] a первый множитель.
+ * @param[in] b второй множитель.
+ * @return a * b, без проверки построения поля.
+ */
+[[nodiscard]]
+uint_fast64_t Field::mul(const uint_fast64_t a, const uint_fast64_t b) const noexcept {
+    if (!exps.empty()) { return a && b ? exps[logs[a] + logs[b]] : 0; }
+    return reduce(Clmul::Product(a, b));
+}
+
+/**
+ * Поэлементно умножает массивы: по таблицам, по восемь элементов
+ * командой VPCLMULQDQ, если она поддерживается (см. mulWide), остаток
+ * и всё остальное - по одному.
+ * @param[in] a первые множители.
+ * @param[in] b вторые множители.
+ * @param[in] stride 1 - b массив, 0 - все элементы умножаются на b[0].
+ * @param[out] res произведения, может совпадать с a или b.
+ * @param[in] count число элементов.
+ */
+void Field::mul(
+        const uint_fast64_t *const a, const uint_fast64_t *const b, const std::size_t stride,
+        uint_fast64_t *const res, const std::size_t count
+) const noexcept {
+    std::size_t i = 0;
+    if (!degree) {
+        for (; i < count; ++i) { res[i] = 0; }
+        return;
+    }
+#ifdef FIELD_X86
+    if (exps.empty() && wide()) { i = mulWide(a, b, stride, res, count, modulus, clmul.Mu(), degree); }
+#endif
+    for (; i < count; ++i) { res[i] = mul(a[i], b[i * stride]); }
+}
+
+/**
+ * @return степень поля n, 0 если модуль приводим.
+ */
+[[nodiscard]]
+uint_fast8_t Field::Degree() const noexcept {
+    return degree;
+}
+
+/**
+ * @return модуль, по которому построено поле.
+ */
+[[nodiscard]]
+uint_fast64_t Field::Modulus() const noexcept {
+    return modulus;
+}
+
+/**
+ * @param[in] a первый множитель, элемент поля.
+ * @param[in] b второй множитель, элемент поля.
+ * @return a * b.
+ */
+[[nodiscard]]
+uint_fast64_t Field::Mul(const uint_fast64_t a, const uint_fast64_t b) const noexcept {
+    return degree ? mul(a, b) : 0;
+}
+
+/**
+ * @param[in] a элемент поля.
+ * @return a^2.
+ */
+[[nodiscard]]
+uint_fast64_t Field::Sqr(const uint_fast64_t a) const noexcept {
+    if (!degree) { return 0; }
+    if (!exps.empty()) { return a ? exps[2u * logs[a]] : 0; }
+    return reduce(Clmul::Product(a, a));
+}
+
+/**
+ * Находит обратный элемент: по таблицам - как степень с логарифмом
+ * 2^n - 1 - log(a), иначе как a^(2^n - 2) методом Ито-Цудзии,
+ * которому нужно n - 1 возведений в квадрат и порядка 2 log n умножений:
+ * b_k = a^(2^k - 1) удваивает k по формуле b_2k = b_k^(2^k) * b_k
+ * и увеличивает на единицу по формуле b_(k+1) = b_k^2 * a
+ * по битам n - 1 от старшего, а a^(-1) = b_(n-1)^2.
+ * @param[in] a элемент поля.
+ * @return a^(-1), 0 для a = 0.
+ */
+[[nodiscard]]
+uint_fast64_t Field::Inv(const uint_fast64_t a) const noexcept {
+    if (!degree || !a) { return 0; }
+    if (!exps.empty()) { return exps[order - logs[a]]; }
+    const uint_fast8_t m = degree - 1u;
+    uint_fast64_t b = a;
+    uint_fast8_t k = 1;
+    for (int_fast8_t i = 62 - __builtin_clzll(m); i >= 0; --i) {
+        uint_fast64_t t = b;
+        for (uint_fast8_t j = 0; j < k; ++j) { t = Sqr(t); }
+        b = mul(t, b);
+        k *= 2u;
+        if ((m >> static_cast<uint_fast8_t>(i)) & 1u) {
+            b = mul(Sqr(b), a);
+            ++k;
+        }
+    }
+    return Sqr(b);
+}
+
+/**
+ * Возводит элемент в степень: по таблицам - умножением логарифма,
+ * иначе возведением в квадрат и умножением по битам показателя
+ * от старшего. Показатель приводится по модулю 2^n - 1, т.к. a^(2^n - 1) = 1.
+ * @param[in] a элемент поля.
+ * @param[in] e показатель.
+ * @return a^e, 1 для e = 0.
+ */
+[[nodiscard]]
+uint_fast64_t Field::Pow(const uint_fast64_t a, uint_fast64_t e) const noexcept {
+    if (!degree) { return 0; }
+    if (!a) { return e ? 0 : 1; }
+    e %= order;
+    if (!exps.empty()) { return exps[logs[a] * e % order]; }
+    uint_fast64_t res = 1;
+    for (int_fast8_t i = e ? 63 - __builtin_clzll(e) : -1; i >= 0; --i) {
+        res = Sqr(res);
+        if ((e >> static_cast<uint_fast8_t>(i)) & 1u) { res = mul(res, a); }
+    }
+    return res;
+}
+
+/**
+ * След элемента Tr(a) = a + a^2 + ... + a^(2^(n-1)) лежит в GF(2)
+ * и линеен по a, поэтому равен чётности числа единичных бит
+ * в a & (Tr(1), Tr(x), ..., Tr(x^(n-1))).
+ * @param[in] a элемент поля.
+ * @return Tr(a).
+ */
+[[nodiscard]]
+bool Field::Trace(const uint_fast64_t a) const noexcept {
+    return __builtin_parityll(a & trace);
+}
+
+/**
+ * Поэлементно умножает массивы: res[i] = a[i] * b[i].
+ * @param[in] a первые множители.
+ * @param[in] b вторые множители.
+ * @param[out] res произведения, может совпадать с a или b.
+ * @param[in] count число элементов.
+ */
+void Field::Mul(
+        const uint_fast64_t *const a, const uint_fast64_t *const b,
+        uint_fast64_t *const res, const std::size_t count
+) const noexcept {
+    mul(a, b, 1, res, count);
+}
+
+/**
+ * Умножает массив на элемент: res[i] = a[i] * c.
+ * @param[in] a множители.
+ * @param[in] c общий множитель.
+ * @param[out] res произведения, может совпадать с a.
+ * @param[in] count число элементов.
+ */
+void Field::Mul(
+        const uint_fast64_t *const a, const uint_fast64_t c,
+        uint_fast64_t *const res, const std::size_t count
+) const noexcept {
+    mul(a, &c, 0, res, count);
+}
+
+/**
+ * Поэлементно возводит массив в квадрат: res[i] = a[i]^2.
+ * @param[in] a элементы поля.
+ * @param[out] res квадраты, может совпадать с a.
+ * @param[in] count число элементов.
+ */
+void Field::Sqr(const uint_fast64_t *const a, uint_fast64_t *const res, const std::size_t count) const noexcept {
+    mul(a, a, 1, res, count);
+}
+
+/**
+ * Поэлементно обращает массив методом Монтгомери: вместо count обращений
+ * выполняется одно обращение произведения всех элементов и 3(count - 1)
+ * умножений. Прямым проходом в res[i] записывается произведение
+ * a[0] * ... * a[i-1], обратным - res[i] = (a[0] * ... * a[i])^(-1) * res[i],
+ * после чего обратное произведение домножается на a[i].
+ * Нулевые элементы пропускаются и остаются нулями. По таблицам обращение
+ * дешевле умножения, поэтому элементы обращаются по одному.
+ * @param[in] a элементы поля.
+ * @param[out] res обратные элементы, не должен пересекаться с a.
+ * @param[in] count число элементов.
+ */
+void Field::Inv(const uint_fast64_t *const a, uint_fast64_t *const res, const std::size_t count) const noexcept {
+    if (!exps.empty()) {
+        for (std::size_t i = 0; i < count; ++i) { res[i] = Inv(a[i]); }
+        return;
+    }
+    uint_fast64_t acc = 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        res[i] = acc;
+        if (a[i]) { acc = Mul(acc, a[i]); }
+    }
+    acc = Inv(acc);
+    for (std::size_t i = count; i-- > 0;) {
+        if (!a[i]) {
+            res[i] = 0;
+            continue;
+        }
+        res[i] = Mul(acc, res[i]);
+        acc = Mul(acc, a[i]);
+    }
+}
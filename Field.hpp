@@ -0,0 +1,77 @@
+/**
+ * @file    Field.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_FIELD_HPP
+#define BERLEKAMP_FIELD_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "Clmul.hpp"
+
+class Field {
+    /// наибольшая степень, для которой умножение выполняется по таблицам
+    static constexpr uint_fast8_t tableDegree = 16;
+
+    std::vector<uint16_t> logs;
+    std::vector<uint16_t> exps;
+    std::array<uint_fast8_t, 4> taps;
+    Clmul clmul;
+    uint_fast64_t modulus;
+    uint_fast64_t mask;
+    uint_fast64_t order;
+    uint_fast64_t trace;
+    uint_fast8_t degree;
+    uint_fast8_t tapsNum;
+
+    [[nodiscard]]
+    uint_fast64_t reduce(unsigned __int128) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t mul(uint_fast64_t, uint_fast64_t) const noexcept;
+
+    void mul(const uint_fast64_t *, const uint_fast64_t *, std::size_t,
+             uint_fast64_t *, std::size_t) const noexcept;
+
+public:
+    explicit
+    Field(uint_fast64_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast8_t Degree() const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Modulus() const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Mul(uint_fast64_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Sqr(uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Inv(uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Pow(uint_fast64_t, uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    bool Trace(uint_fast64_t) const noexcept;
+
+    void Mul(const uint_fast64_t *, const uint_fast64_t *, uint_fast64_t *, std::size_t) const noexcept;
+
+    void Mul(const uint_fast64_t *, uint_fast64_t, uint_fast64_t *, std::size_t) const noexcept;
+
+    void Sqr(const uint_fast64_t *, uint_fast64_t *, std::size_t) const noexcept;
+
+    void Inv(const uint_fast64_t *, uint_fast64_t *, std::size_t) const noexcept;
+};
+
+#endif //BERLEKAMP_FIELD_HPP
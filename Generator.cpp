@@ -7,105 +7,575 @@
  * @url     https://github.com/vadimpiven/irrpolygf2
  */
 
+#include <random>
 #include <thread>
-#include <pthread.h>
 
-#include "Random.hpp"
+#include "Batch.hpp"
+#include "Sparse.hpp"
 #include "Generator.hpp"
 
 /**
- * @param[in] c список текущих проверщиков
- * @return число активно работающих проверщиков
+ * Создаёт генератор и запускает пул рабочих потоков, которые живут
+ * до уничтожения генератора. Потоки, их буферы под матрицу Берлекампа
+ * и состояние генератора случайных чисел переиспользуются между вызовами
+ * GetIrrPoly, поэтому создание потоков не входит во время отдельного вызова.
+ * Начальное значение генераторов случайных чисел выбирается случайно,
+ * для воспроизводимых результатов его следует задать вызовом SetSeed.
+ * @param[in] threadsNum число рабочих потоков,
+ * 0 - по числу потоков, доступных в системе.
  */
+Generator::Generator(uint_fast8_t threadsNum) noexcept :
+        call(PTHREAD_MUTEX_INITIALIZER), mutex(PTHREAD_MUTEX_INITIALIZER),
+        hasResult(PTHREAD_COND_INITIALIZER), job(0), tested(0), rejected(0), waiting(false),
+        method(Polynomial<>::Method::Auto), bound(8), epoch(0), busy(0), stop(false) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        threadsNum = cores > 0 ? cores : 1;
+    }
+    // адреса элементов не должны меняться после запуска потоков,
+    // поэтому все элементы создаются сразу
+    workers = std::vector<Worker>(threadsNum);
+    for (auto &w : workers) {
+        w.owner = this;
+        w.stats = nullptr;
+        w.consumed.store(0, std::memory_order_relaxed);
+        w.asleep.store(false, std::memory_order_relaxed);
+        pthread_cond_init(&w.wake, nullptr);
+        for (auto &b : w.blocks) { b.tag.store(0, std::memory_order_relaxed); }
+    }
+    seed(std::random_device()());
+    for (uint_fast8_t i = 0; i < threadsNum; ++i) {
+        if (pthread_create(&workers[i].thread, nullptr, &work, &workers[i])) {
+            while (workers.size() > i) {
+                pthread_cond_destroy(&workers.back().wake);
+                workers.pop_back();
+            }
+            break;
+        }
+    }
+}
+
+/**
+ * Останавливает пул и дожидается завершения всех рабочих потоков.
+ */
+Generator::~Generator() noexcept {
+    pthread_mutex_lock(&mutex);
+    stop = true;
+    wakeAll();
+    pthread_mutex_unlock(&mutex);
+    for (auto &w : workers) { pthread_join(w.thread, nullptr); }
+    for (auto &w : workers) { pthread_cond_destroy(&w.wake); }
+    pthread_cond_destroy(&hasResult);
+    pthread_mutex_destroy(&mutex);
+    pthread_mutex_destroy(&call);
+}
+
+/**
+ * Будит все спящие рабочие потоки. Вызывающий поток
+ * должен удерживать мьютекс mutex.
+ */
+void Generator::wakeAll() noexcept {
+    for (auto &w : workers) {
+        if (w.asleep.load()) { pthread_cond_signal(&w.wake); }
+    }
+}
+
+/**
+ * Задаёт начальные состояния генераторов случайных чисел рабочих потоков:
+ * поток номер i начинает с состояния xoshiro256**, продвинутого
+ * i раз на 2^128 шагов (см. Xoshiro::Jump), поэтому последовательности
+ * кандидатов разных потоков не пересекаются. Для задач пула (см. run)
+ * каждый поток получает ещё одну последовательность search, следующую
+ * за последовательностями всех потоков, чтобы многословные кандидаты
+ * не повторяли кандидатов GetIrrPoly. Вызывающий поток
+ * не должен выполнять generate одновременно с этим вызовом.
+ * @param[in] value начальное значение.
+ */
+void Generator::seed(const uint_fast64_t value) noexcept {
+    Xoshiro state(value);
+    pthread_mutex_lock(&mutex);
+    for (auto &w : workers) {
+        w.start = state;
+        state.Jump();
+    }
+    for (auto &w : workers) {
+        w.search = state;
+        state.Jump();
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+/**
+ * Цикл рабочего потока: сам генерирует блоки по blockSize кандидатов
+ * собственным генератором случайных чисел (см. seed), отбрасывает многочлены
+ * с делителями малой степени (см. Checker::Reject), оставшиеся проверяет
+ * на неприводимость одновременно и записывает найденные в очередной блок
+ * своего кольца. Параметры текущего вызова generate упакованы в одно
+ * атомарное слово job. Поток опережает выдачу не более чем на ahead блоков,
+ * после чего засыпает, пока generate не заберёт очередной блок; мьютекс
+ * берётся только для сна, для смены вызова и чтобы разбудить generate.
+ * Если вызова нет, но задана задача task (поиск многословных многочленов),
+ * поток выполняет её шаги со своей последовательностью search (см. seed),
+ * пока один из них не вернёт false.
+ * При поиске примитивных многочленов неприводимые кандидаты дополнительно
+ * проверяются на максимальность порядка (см. Polynomial::HasMaximalOrder).
+ * @param arg экземпляр Worker, принадлежащий данному потоку.
+ * @return nullptr после остановки генератора.
+ */
+void *Generator::work(void *arg) noexcept {
+    auto *w = static_cast<Worker *>(arg);
+    auto *g = w->owner;
+    Xoshiro rng;
+    uint_fast64_t p[blockSize], j, c, local = 0;
+    bool irr[blockSize];
+    std::size_t k, i, fresh;
+    uint_fast32_t e = 0;
+    Polynomial<>::Method m;
+    uint_fast8_t d, b;
+    bool prim;
+
+    pthread_mutex_lock(&g->mutex);
+    w->stats = Stats::Current();
+    pthread_mutex_unlock(&g->mutex);
+    while (true) {
+        j = g->job.load(std::memory_order_acquire);
+        d = j & 0xFFu;
+        if (d != 0 && (j >> 32u) != e) {
+            // новый вызов: поток продолжается с того места, до которого
+            // предыдущий вызов забрал его блоки (см. generate)
+            pthread_mutex_lock(&g->mutex);
+            if (g->job.load(std::memory_order_relaxed) == j) {
+                rng = w->start;
+                e = j >> 32u;
+                local = 0;
+            }
+            pthread_mutex_unlock(&g->mutex);
+            continue;
+        }
+        c = w->consumed.load();
+        if (d == 0 || local >= ((c >> 32u) == e ? c & 0xFF'FF'FF'FFu : 0) + ahead) {
+            pthread_mutex_lock(&g->mutex);
+            w->asleep.store(true);
+            if (!g->stop && !g->task && g->job.load() == j && w->consumed.load() == c) {
+                pthread_cond_wait(&w->wake, &g->mutex);
+            }
+            w->asleep.store(false);
+            if (g->stop) {
+                pthread_mutex_unlock(&g->mutex);
+                break;
+            }
+            if (g->task && (g->job.load(std::memory_order_relaxed) & 0xFFu) == 0) {
+                auto step = g->task;
+                ++g->busy;
+                pthread_mutex_unlock(&g->mutex);
+                const bool more = step(w->search);
+                pthread_mutex_lock(&g->mutex);
+                --g->busy;
+                if (!more) { g->task = nullptr; }
+                // run ждёт, пока задача не снята и все начатые шаги не завершены
+                if (!g->task && g->busy == 0) { pthread_cond_signal(&g->hasResult); }
+            }
+            pthread_mutex_unlock(&g->mutex);
+            continue;
+        }
+        b = (j >> 8u) & 0xFFu;
+        m = static_cast<Polynomial<>::Method>((j >> 16u) & 0xFFu);
+        prim = (j >> 24u) & 1u;
+
+        STATS_CLOCK(t);
+        for (k = 0; k < blockSize; ++k) {
+            // младший и старший коэффициенты всегда единицы
+            p[k] = (1ull << d) | (rng.Next() >> (65u - d) << 1u) | 1ull;
+        }
+        if (w->checker.Bound() != b) { w->checker.SetPrefilter(b); }
+        for (i = fresh = 0; i < k; ++i) {
+            if (!w->checker.Reject(p[i], d)) { p[fresh++] = p[i]; }
+        }
+        if (b) {
+            g->tested.fetch_add(k, std::memory_order_relaxed);
+            g->rejected.fetch_add(k - fresh, std::memory_order_relaxed);
+        }
+        k = fresh;
+        if (m == Polynomial<>::Method::Auto && b) {
+            // см. Checker::Check
+            m = Polynomial<>::Method::Berlekamp;
+        }
+        Batch::Check(p, irr, k, d, m);
+        Block &block = w->blocks[local % ahead];
+        for (i = fresh = 0; i < k; ++i) {
+            if (irr[i] && (!prim || Polynomial(p[i]).HasMaximalOrder(d))) { block.poly[fresh++] = p[i]; }
+        }
+        block.count = fresh;
+        STATS_LAP(t, Block, d, blockSize, blockSize - fresh);
+        block.next = rng;
+        block.tag.store(uint_fast64_t(e) << 32u | ++local);
+        if (g->waiting.load()) {
+            pthread_mutex_lock(&g->mutex);
+            pthread_cond_signal(&g->hasResult);
+            pthread_mutex_unlock(&g->mutex);
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * Выполняет задачу на всех рабочих потоках пула: каждый свободный поток
+ * вызывает task со своим генератором случайных чисел search (см. seed),
+ * пока один из вызовов не вернёт false, после чего
+ * дожидается завершения уже начатых вызовов. Вызывающий поток
+ * должен удерживать мьютекс call.
+ * @param[in] task шаг задачи, возвращает, нужно ли продолжать.
+ */
+void Generator::run(const std::function<bool(Xoshiro &)> &task) noexcept {
+    pthread_mutex_lock(&mutex);
+    this->task = task;
+    wakeAll();
+    // задача снимается первым потоком, получившим false,
+    // остальные потоки дожидаются завершения начатых проверок
+    while (this->task || busy) {
+        pthread_cond_wait(&hasResult, &mutex);
+    }
+    pthread_mutex_unlock(&mutex);
+}
+
+/**
+ * Находит наименьший в каноническом порядке (см. Sparse::Next) неприводимый
+ * трёхчлен или пятичлен заданной степени. Кандидаты выдаются рабочим
+ * потокам по порядку, и выдача прекращается, как только номер очередного
+ * кандидата превысит номер наименьшего найденного неприводимого.
+ * Все кандидаты с меньшими номерами к этому моменту уже выданы, поэтому
+ * после завершения начатых проверок найденный многочлен - наименьший,
+ * и результат не зависит от числа потоков и порядка их работы.
+ * @tparam Words число 64-битных слов в представлении многочлена.
+ * @param[in] degree степень многочлена, от 2 до 64 * Words - 1.
+ * @return степени ненулевых членов многочлена по убыванию,
+ * пустой список, если подходящих многочленов нет.
+ */
+template<std::size_t Words>
 [[nodiscard]]
-uint_fast8_t Generator::countBusy(const std::vector<Checker> &c) noexcept {
-    uint_fast8_t n = 0;
-    for (auto &checker : c) { n += checker.IsNotDone(); }
-    return n;
+std::vector<uint_fast16_t> Generator::sparse(const uint_fast16_t degree) noexcept {
+    Sparse<Words> next(degree);
+    std::vector<uint_fast16_t> res;
+    uint_fast64_t issued = 0;
+    std::atomic<uint_fast64_t> best(UINT64_MAX);
+    bool more = true;
+    run([this, &next, &res, &issued, &best, &more](Xoshiro &) {
+        pthread_mutex_lock(&mutex);
+        if (more && issued < best.load(std::memory_order_relaxed)) { more = next.Next(); }
+        if (!more || issued >= best.load(std::memory_order_relaxed)) {
+            pthread_mutex_unlock(&mutex);
+            return false;
+        }
+        const Sparse<Words> candidate = next;
+        const uint_fast64_t number = issued++;
+        pthread_mutex_unlock(&mutex);
+
+        if (!candidate.IsIrredusible()) { return true; }
+        pthread_mutex_lock(&mutex);
+        if (number < best.load(std::memory_order_relaxed)) {
+            best.store(number, std::memory_order_relaxed);
+            res = candidate.Exponents();
+        }
+        pthread_mutex_unlock(&mutex);
+        return true;
+    });
+    return res;
 }
 
 /**
- * Генерирует неприводимый многочлен заданной степени, используя несколько потоков.
+ * Генерирует различные неприводимые многочлены заданной степени, используя пул потоков.
  * Генерация проходит путём последовательной проверки случайно выбранных многочленов
  * заданной степени. Всегда выбираются многочлены, у которых младший и старший
  * коэффициенты не нулевые. Случай degree = 1 не подходит под это правило,
- * т.к. все полиномы первой степени неприводимы над полем GF[2], поэтому один
- * из них возвращается случайным образом (случай рассмотрен отдельно)
- * @param[in] degree степень генерируемого многочлена, от 1 до 63,
+ * т.к. все полиномы первой степени неприводимы над полем GF[2], поэтому
+ * они возвращаются в случайном порядке (случай рассмотрен отдельно).
+ * Кандидатов генерируют сами рабочие потоки блоками по blockSize штук:
+ * блок номер b генерирует поток b mod T (T - число потоков) из своей
+ * последовательности случайных чисел, а вызывающий поток забирает блоки
+ * строго по порядку номеров, отбрасывает повторы и передаёт найденные
+ * многочлены в callback. Поэтому результат не зависит от скорости потоков
+ * и однозначно определяется начальным значением (см. SetSeed), числом
+ * потоков и последовательностью вызовов. Как только получено count
+ * многочленов, вызов завершается, не дожидаясь начатых проверок: каждый
+ * поток продолжит следующий вызов с места, до которого были забраны
+ * его блоки, а блоки, сгенерированные сверх этого, отбрасываются.
+ * @param[in] d степень генерируемых многочленов, от 1 до 63,
  * не проверяется корректность для уменьшания числа выполняемых операций.
- * @param[in] threadsNum число потоков.
- * @return неприводимый многочлен требуемой степени,
- * 1 в случае ошибки pthread.
+ * @param[in] count число требуемых многочленов, не больше
+ * числа неприводимых (примитивных) многочленов степени d.
+ * @param[in] prim искать только примитивные многочлены.
+ * @param[in] callback вызывается в текущем потоке для каждого найденного многочлена.
+ * @return число переданных в callback многочленов.
  */
-[[nodiscard]]
-uint_fast64_t Generator::generate(const uint_fast8_t degree, const uint_fast8_t threadsNum) noexcept {
-    if (degree == 1) {
-        // случайным образом возвращаем либо x, либо x+1
-        return Random(1) ? 2ull : 3ull;
+std::size_t Generator::generate(
+        const uint_fast8_t d, const std::size_t count, const bool prim,
+        const std::function<void(uint_fast64_t)> &callback
+) noexcept {
+    if (d == 1 && prim) {
+        // x + 1 - единственный примитивный многочлен первой степени
+        callback(3ull);
+        return 1;
     }
-    uint_fast64_t res; // возвращаемое значение
-
-    // всё для работы с потоками
-    pthread_t threads[threadsNum];
-    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
-    pthread_mutexattr_t attr;
-    pthread_cond_t cond = PTHREAD_COND_INITIALIZER;
-
-    if (pthread_mutexattr_init(&attr) ||
-            pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_ERRORCHECK) ||
-            pthread_mutex_init(&mutex, &attr) ||
-            pthread_cond_init(&cond, nullptr)) { return 1; }
-
-    // по одному проверщику в каждом потоке
-    auto c = std::vector<Checker>(threadsNum, Checker(&mutex, &cond));
+    if (d == 1) {
+        // случайным образом выбираем порядок x и x+1
+        pthread_mutex_lock(&mutex);
+        const uint_fast64_t first = workers.front().start.Next() >> 63u ? 2ull : 3ull;
+        pthread_mutex_unlock(&mutex);
+        callback(first);
+        if (count > 1) { callback(first ^ 1ull); }
+        return count;
+    }
+    std::vector<Xoshiro> resume(workers.size());
+    std::vector<bool> used(workers.size(), false);
+    std::size_t done = 0;
+    seen.clear();
 
     pthread_mutex_lock(&mutex);
-    while (true) {
-        while (countBusy(c) >= threadsNum) {
-            // ждём изменения числа занятых потоков
-            pthread_cond_wait(&cond, &mutex);
-        }
+    const uint_fast32_t e = ++epoch;
+    // epoch | primitive | method | bound | degree
+    job.store(uint_fast64_t(e) << 32u | uint_fast64_t(prim) << 24u |
+              uint_fast64_t(method) << 16u | uint_fast64_t(bound) << 8u | d,
+              std::memory_order_release);
+    wakeAll();
+    pthread_mutex_unlock(&mutex);
 
-        for (uint_fast8_t j = 0; j < threadsNum; ++j) {
-            // находим первый свободный поток
-            if (c[j].IsNotDone()) { continue; }
-            if (c[j].IsIrreducible()) {
-                res = c[j].Get();
-                goto END;
+    for (uint_fast64_t b = 0; done < count; ++b) {
+        const std::size_t w = b % workers.size();
+        const uint_fast64_t local = b / workers.size();
+        const uint_fast64_t tag = uint_fast64_t(e) << 32u | (local + 1);
+        Worker &worker = workers[w];
+        const Block &block = worker.blocks[local % ahead];
+        if (block.tag.load(std::memory_order_acquire) != tag) {
+            pthread_mutex_lock(&mutex);
+            waiting.store(true);
+            while (block.tag.load() != tag) {
+                pthread_cond_wait(&hasResult, &mutex);
             }
-            // генерируем случайный многочлен для проверки
-            // младший и старший коэффициенты всегда единицы
-            c[j].Set((1ull << degree) | (Random(degree - 1ull) << 1ull) | 1ull, degree);
-            // создаём новый поток для выполнения проверки
-            pthread_create(&threads[j], nullptr, &Checker::Check, &c[j]);
-            // отсоединеняем поток
-            pthread_detach(threads[j]);
-            break;
+            waiting.store(false);
+            pthread_mutex_unlock(&mutex);
+        }
+        // рабочие потоки продолжают проверку, пока вызывается callback
+        for (uint_fast8_t i = 0; i < block.count && done < count; ++i) {
+            if (!seen.insert(block.poly[i]).second) { continue; }
+            callback(block.poly[i]);
+            ++done;
+        }
+        resume[w] = block.next;
+        used[w] = true;
+        // освобождаем место в кольце потока
+        worker.consumed.store(tag);
+        if (worker.asleep.load()) {
+            pthread_mutex_lock(&mutex);
+            pthread_cond_signal(&worker.wake);
+            pthread_mutex_unlock(&mutex);
         }
     }
-    END:
-    // ждём завершения всех созданных потоков
-    while (countBusy(c)) {
-        pthread_cond_wait(&cond, &mutex);
+
+    pthread_mutex_lock(&mutex);
+    for (std::size_t w = 0; w < workers.size(); ++w) {
+        if (used[w]) { workers[w].start = resume[w]; }
     }
+    // начатые проверки не дожидаемся: с новым номером вызова
+    // их результаты никто не заберёт
+    job.store(uint_fast64_t(++epoch) << 32u, std::memory_order_release);
     pthread_mutex_unlock(&mutex);
-    if (pthread_cond_destroy(&cond) || pthread_mutex_destroy(&mutex)
-        || pthread_mutexattr_destroy(&attr)) { return 1; }
-    return res;
+    return done;
+}
+
+/**
+ * Задаёт алгоритм проверки неприводимости для всех последующих вызовов.
+ * @param[in] m алгоритм проверки, по умолчанию (Auto) выбирается по степени.
+ */
+void Generator::SetMethod(const Polynomial<>::Method m) noexcept {
+    pthread_mutex_lock(&call);
+    pthread_mutex_lock(&mutex);
+    method = m;
+    pthread_mutex_unlock(&mutex);
+    pthread_mutex_unlock(&call);
+}
+
+/**
+ * Задаёт наибольшую степень делителей, по которым кандидаты отбраковываются
+ * до основной проверки (см. Polynomial::HasSmallFactor), и сбрасывает
+ * статистику отбраковки.
+ * @param[in] bound наибольшая степень делителя, от 0 до 8 (по умолчанию 8),
+ * 0 отключает отбраковку.
+ */
+void Generator::SetPrefilter(const uint_fast8_t bound) noexcept {
+    pthread_mutex_lock(&call);
+    this->bound = bound;
+    tested.store(0, std::memory_order_relaxed);
+    rejected.store(0, std::memory_order_relaxed);
+    pthread_mutex_unlock(&call);
+}
+
+/**
+ * Задаёт начальное значение генераторов случайных чисел рабочих потоков.
+ * После этого вызова результаты GetIrrPoly, GetPrimitivePoly и GetIrrPolys
+ * однозначно определяются начальным значением, числом рабочих потоков
+ * и последовательностью вызовов (см. generate), что позволяет повторить
+ * и проверить любой запуск. Кандидаты многословных многочленов
+ * (GetIrrPoly<Words>) также берутся из заданных этим значением
+ * последовательностей, но результат выдаётся первым нашедшим его потоком
+ * и потому от запуска к запуску может отличаться.
+ * @param[in] value начальное значение.
+ */
+void Generator::SetSeed(const uint_fast64_t value) noexcept {
+    pthread_mutex_lock(&call);
+    seed(value);
+    pthread_mutex_unlock(&call);
+}
+
+/**
+ * Возвращает долю кандидатов, отброшенных на ступени отбраковки по делителям
+ * малой степени, с момента создания генератора или последнего SetPrefilter.
+ * Счётчики общие для всех рабочих потоков и увеличиваются атомарно
+ * после каждой группы кандидатов.
+ * @return доля отброшенных кандидатов от 0 до 1,
+ * 0 если отбраковка отключена или ещё не выполнялась.
+ */
+[[nodiscard]]
+double Generator::GetPrefilterHitRate() noexcept {
+    const uint_fast64_t t = tested.load(std::memory_order_relaxed);
+    const uint_fast64_t r = rejected.load(std::memory_order_relaxed);
+    return t ? static_cast<double>(r) / static_cast<double>(t) : 0.0;
+}
+
+/**
+ * Возвращает счётчики ступеней проверки (см. Stats), накопленные рабочими
+ * потоками данного генератора с момента его создания: отбраковку,
+ * ступени проверки и блоки кандидатов (Stats::Stage::Block - полное
+ * время подготовки блока потоком и число отброшенных в нём кандидатов).
+ * Проверки, выполняемые вызывающим потоком, сюда не входят
+ * (см. Polynomial<1>::GetStats). Счётчики собираются только в сборке
+ * с BERLEKAMP_STATS, иначе таблица нулевая.
+ * @return таблица счётчиков Table[stage][degree].
+ */
+[[nodiscard]]
+Stats::Table Generator::GetStats() noexcept {
+    std::vector<const Stats::Local *> locals;
+    pthread_mutex_lock(&mutex);
+    for (const auto &w : workers) { locals.push_back(w.stats); }
+    pthread_mutex_unlock(&mutex);
+    return Stats::Collect(locals);
 }
 
 /**
  * Генерирует неприводимый многочлен заданной степени.
- * При вызове подсчитывает число доступных потоков обращением к std::threads.
+ * Одновременные вызовы для одного генератора выполняются по очереди.
  * @param[in] degree степень многочлена в пределах от 1 до 63,
  * проверка попадания в эти границы выполняется.
  * @return неприводимый многочлен требуемой степени,
  * 0 в случае если degree задан некорректно,
- * 1 в случае ошибки pthread.
+ * 1 в случае если не удалось запустить ни одного рабочего потока.
  */
 [[nodiscard]]
 uint_fast64_t Generator::GetIrrPoly(const uint_fast8_t degree) noexcept {
     if (degree == 0 || degree > 63) { return 0; }
-    static const uint_fast8_t cores = std::thread::hardware_concurrency();
-    return generate(degree, cores > 0 ? cores : 1);
+    if (workers.empty()) { return 1; }
+    uint_fast64_t res = 0;
+    pthread_mutex_lock(&call);
+    (void) generate(degree, 1, false, [&res](const uint_fast64_t p) { res = p; });
+    pthread_mutex_unlock(&call);
+    return res;
+}
+
+/**
+ * Находит неприводимый многочлен заданной степени с наименьшим числом
+ * ненулевых коэффициентов: наименьший неприводимый трёхчлен x^n + x^k + 1
+ * (наименьшее k), а если таких нет - наименьший пятичлен
+ * x^n + x^k3 + x^k2 + x^k1 + 1 (наименьшие k3, затем k2, затем k1).
+ * Результат однозначен и совпадает с общепринятыми таблицами,
+ * например для степеней 233, 409 и 571. Кандидаты проверяются параллельно
+ * пулом рабочих потоков (см. sparse), проверка использует разреженность
+ * многочлена (см. Sparse::IsIrredusible).
+ * @param[in] degree степень многочлена в пределах от 2 до 2047,
+ * проверка попадания в эти границы выполняется.
+ * @return степени ненулевых членов многочлена по убыванию, включая degree и 0,
+ * пустой список, если degree задан некорректно
+ * или не удалось запустить ни одного рабочего потока.
+ */
+[[nodiscard]]
+std::vector<uint_fast16_t> Generator::GetSparsePoly(const uint_fast16_t degree) noexcept {
+    if (degree < 2 || degree > 2047 || workers.empty()) { return {}; }
+    const uint_fast16_t words = degree / 64 + 1;
+    std::vector<uint_fast16_t> res;
+    pthread_mutex_lock(&call);
+    if (words <= 1) { res = sparse<1>(degree); }
+    else if (words <= 2) { res = sparse<2>(degree); }
+    else if (words <= 4) { res = sparse<4>(degree); }
+    else if (words <= 8) { res = sparse<8>(degree); }
+    else if (words <= 16) { res = sparse<16>(degree); }
+    else { res = sparse<32>(degree); }
+    pthread_mutex_unlock(&call);
+    return res;
+}
+
+/**
+ * Генерирует примитивный многочлен заданной степени, т.е. неприводимый
+ * многочлен порядка 2^degree - 1, пригодный в качестве обратной связи
+ * регистра сдвига максимального периода. Проверка выполняется тем же
+ * пулом рабочих потоков, что и в GetIrrPoly: среди неприводимых
+ * многочленов примитивна доля phi(2^n - 1) / (2^n - 1), поэтому
+ * поиск в среднем дольше не более чем в несколько раз.
+ * @param[in] degree степень многочлена в пределах от 1 до 63,
+ * проверка попадания в эти границы выполняется.
+ * @return примитивный многочлен требуемой степени,
+ * 0 в случае если degree задан некорректно,
+ * 1 в случае если не удалось запустить ни одного рабочего потока.
+ */
+[[nodiscard]]
+uint_fast64_t Generator::GetPrimitivePoly(const uint_fast8_t degree) noexcept {
+    if (degree == 0 || degree > 63) { return 0; }
+    if (workers.empty()) { return 1; }
+    uint_fast64_t res = 0;
+    pthread_mutex_lock(&call);
+    (void) generate(degree, 1, true, [&res](const uint_fast64_t p) { res = p; });
+    pthread_mutex_unlock(&call);
+    return res;
+}
+
+/**
+ * Генерирует count различных неприводимых многочленов заданной степени.
+ * @param[in] degree степень многочленов в пределах от 1 до 63,
+ * проверка попадания в эти границы выполняется.
+ * @param[in] count число требуемых многочленов, не больше
+ * числа неприводимых многочленов данной степени.
+ * @return различные неприводимые многочлены в порядке их нахождения,
+ * пустой список в случае некорректных параметров
+ * или если не удалось запустить ни одного рабочего потока.
+ */
+[[nodiscard]]
+std::vector<uint_fast64_t> Generator::GetIrrPolys(
+        const uint_fast8_t degree, const std::size_t count
+) noexcept {
+    std::vector<uint_fast64_t> res;
+    res.reserve(degree == 0 || degree > 63 ? 0 : count);
+    (void) GetIrrPolys(degree, count, [&res](const uint_fast64_t p) { res.push_back(p); });
+    return res;
+}
+
+/**
+ * Потоковый вариант GetIrrPolys: каждый найденный многочлен сразу передаётся
+ * в callback, который вызывается в текущем потоке, пока рабочие потоки
+ * продолжают поиск. Одновременные вызовы для одного генератора
+ * выполняются по очереди.
+ * @param[in] degree степень многочленов в пределах от 1 до 63,
+ * проверка попадания в эти границы выполняется.
+ * @param[in] count число требуемых многочленов, не больше
+ * числа неприводимых многочленов данной степени.
+ * @param[in] callback получает по одному разу каждый найденный многочлен.
+ * @return число переданных в callback многочленов, 0 в случае некорректных
+ * параметров или если не удалось запустить ни одного рабочего потока.
+ */
+std::size_t Generator::GetIrrPolys(
+        const uint_fast8_t degree, const std::size_t count,
+        const std::function<void(uint_fast64_t)> &callback
+) noexcept {
+    if (degree == 0 || degree > 63 || count == 0 ||
+        count > Polynomial<>::Count(degree) || workers.empty()) { return 0; }
+    pthread_mutex_lock(&call);
+    auto res = generate(degree, count, false, callback);
+    pthread_mutex_unlock(&call);
+    return res;
 }
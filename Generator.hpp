@@ -10,20 +10,175 @@
 #ifndef BERLEKAMP_GENERATOR_HPP
 #define BERLEKAMP_GENERATOR_HPP
 
+#include <array>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <unordered_set>
 #include <vector>
+#include <pthread.h>
 #include "Checker.hpp"
+#include "Stats.hpp"
+#include "Xoshiro.hpp"
 
 class Generator {
-    [[nodiscard]] static
-    uint_fast8_t countBusy(const std::vector<Checker> &) noexcept;
+    /// число кандидатов в блоке, не зависит от Batch::Lanes
+    static constexpr std::size_t blockSize = 16;
+    /// число блоков, на которое рабочий поток может опередить выдачу
+    static constexpr std::size_t ahead = 8;
 
-    [[nodiscard]] static
-    uint_fast64_t generate(uint_fast8_t, uint_fast8_t) noexcept;
+    struct Block {
+        std::atomic<uint_fast64_t> tag;
+        uint_fast8_t count;
+        std::array<uint_fast64_t, blockSize> poly;
+        Xoshiro next;
+    };
+
+    struct Worker {
+        Generator *owner;
+        Checker checker;
+        Xoshiro start;
+        Xoshiro search;
+        std::array<Block, ahead> blocks;
+        std::atomic<uint_fast64_t> consumed;
+        std::atomic<bool> asleep;
+        pthread_cond_t wake;
+        pthread_t thread;
+        const Stats::Local *stats;
+    };
+
+    std::vector<Worker> workers;
+    std::unordered_set<uint_fast64_t> seen;
+
+    pthread_mutex_t call;
+    pthread_mutex_t mutex;
+    pthread_cond_t hasResult;
+
+    std::function<bool(Xoshiro &)> task;
+
+    std::atomic<uint_fast64_t> job;
+    std::atomic<uint_fast64_t> tested;
+    std::atomic<uint_fast64_t> rejected;
+    std::atomic<bool> waiting;
+
+    Polynomial<>::Method method;
+    uint_fast8_t bound;
+    uint_fast32_t epoch;
+    uint_fast8_t busy;
+    bool stop;
+
+    static
+    void *work(void *) noexcept;
+
+    void wakeAll() noexcept;
+
+    void seed(uint_fast64_t) noexcept;
+
+    void run(const std::function<bool(Xoshiro &)> &) noexcept;
+
+    template<std::size_t Words>
+    [[nodiscard]]
+    std::vector<uint_fast16_t> sparse(uint_fast16_t) noexcept;
+
+    [[nodiscard]]
+    std::size_t generate(uint_fast8_t, std::size_t, bool,
+                         const std::function<void(uint_fast64_t)> &) noexcept;
 
 public:
-    [[nodiscard]] static
+    explicit
+    Generator(uint_fast8_t = 0) noexcept;
+
+    Generator(const Generator &) = delete;
+
+    Generator &operator=(const Generator &) = delete;
+
+    ~Generator() noexcept;
+
+    void SetMethod(Polynomial<>::Method) noexcept;
+
+    void SetPrefilter(uint_fast8_t) noexcept;
+
+    void SetSeed(uint_fast64_t) noexcept;
+
+    [[nodiscard]]
+    double GetPrefilterHitRate() noexcept;
+
+    [[nodiscard]]
+    Stats::Table GetStats() noexcept;
+
+    [[nodiscard]]
     uint_fast64_t GetIrrPoly(uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t GetPrimitivePoly(uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    std::vector<uint_fast16_t> GetSparsePoly(uint_fast16_t) noexcept;
+
+    [[nodiscard]]
+    std::vector<uint_fast64_t> GetIrrPolys(uint_fast8_t, std::size_t) noexcept;
+
+    std::size_t GetIrrPolys(uint_fast8_t, std::size_t,
+                            const std::function<void(uint_fast64_t)> &) noexcept;
+
+    template<std::size_t Words>
+    [[nodiscard]]
+    Polynomial<Words> GetIrrPoly(uint_fast16_t) noexcept;
 };
 
+/**
+ * Генерирует неприводимый многочлен степени больше 63, например 127, 233, 409,
+ * 571 или 2039, и возвращает его как многословный многочлен.
+ * Поиск выполняется тем же пулом рабочих потоков: каждый свободный поток
+ * берёт случайного кандидата из собственной последовательности
+ * (см. Generator::seed) и проверяет его, пока один из них
+ * не окажется неприводимым. Как только многочлен найден, начатые проверки
+ * остальных потоков прерываются между строками матрицы Берлекампа,
+ * поэтому результат возвращается, не дожидаясь их завершения.
+ * Для степеней до 63 вызывается обычный GetIrrPoly.
+ * Одновременные вызовы для одного генератора выполняются по очереди.
+ * @tparam Words число 64-битных слов в представлении многочлена.
+ * @param[in] degree степень многочлена в пределах от 1 до 64 * Words - 1,
+ * проверка попадания в эти границы выполняется.
+ * @return неприводимый многочлен требуемой степени,
+ * 0 в случае если degree задан некорректно,
+ * 1 в случае если не удалось запустить ни одного рабочего потока.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+Polynomial<Words> Generator::GetIrrPoly(const uint_fast16_t degree) noexcept {
+    if (degree < 64) { return Polynomial<Words>(GetIrrPoly(uint_fast8_t(degree))); }
+    if (degree >= 64 * Words) { return Polynomial<Words>(0); }
+    if (workers.empty()) { return Polynomial<Words>(1); }
+
+    std::array<uint_fast64_t, Words> res{};
+    std::atomic<bool> done(false);
+    pthread_mutex_lock(&call);
+    run([this, degree, &res, &done](Xoshiro &rng) {
+        if (done.load(std::memory_order_relaxed)) { return false; }
+        std::array<uint_fast64_t, Words> p{};
+        // младший и старший коэффициенты всегда единицы
+        for (uint_fast16_t i = 0; i < degree; i += 64) {
+            p[i >> 6u] = rng.Next();
+        }
+        p[degree >> 6u] &= (1ull << (degree & 63u)) - 1;
+        p[degree >> 6u] |= 1ull << (degree & 63u);
+        p[0] |= 1u;
+
+        // проверки остальных потоков прерываются, как только многочлен найден
+        const auto cancelled = [&done] { return done.load(std::memory_order_relaxed); };
+        if (!Polynomial<Words>(p).IsIrredusible(degree, cancelled)) { return true; }
+        pthread_mutex_lock(&mutex);
+        if (!done.load(std::memory_order_relaxed)) {
+            res = p;
+            done.store(true, std::memory_order_relaxed);
+        }
+        pthread_mutex_unlock(&mutex);
+        return false;
+    });
+    pthread_mutex_unlock(&call);
+    return Polynomial<Words>(res);
+}
+
 #endif //BERLEKAMP_GENERATOR_HPP
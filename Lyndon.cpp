@@ -0,0 +1,261 @@
+/**
+ * @file    Lyndon.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <thread>
+
+#include "Lyndon.hpp"
+#include "Polynomial.hpp"
+
+/**
+ * Число первых букв слова, по которым перебор делится между потоками:
+ * получается около 2^depth / depth * 2 независимых частей.
+ */
+static const uint_fast8_t depth = 14;
+
+/**
+ * Число найденных многочленов, накапливаемых рабочим потоком перед выдачей.
+ */
+static const std::size_t batch = 4096;
+
+/**
+ * Создаёт объект для перечисления неприводимых многочленов заданной степени.
+ * @param[in] threadsNum число потоков, используемых при переборе,
+ * 0 - по числу потоков, доступных в системе.
+ */
+Lyndon::Lyndon(uint_fast8_t threadsNum) noexcept :
+        taken(0), output(PTHREAD_MUTEX_INITIALIZER), callback(nullptr),
+        modulus(0), trace(0), degree(0), threadsNum(threadsNum) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        this->threadsNum = cores > 0 ? cores : 1;
+    }
+}
+
+/**
+ * Перебирает начала слов (предожерелий) длины до depth алгоритмом
+ * Фредриксена-Кесслера-Майораны и запоминает их как отдельные задачи.
+ * Буква a[t] слова хранится в бите n - t, поэтому лексикографический
+ * порядок слов совпадает с порядком чисел, а a[0] = 0 - бит n.
+ * @param[in] word первые t - 1 букв слова.
+ * @param[in] t номер следующей буквы, от 1.
+ * @param[in] p период начала слова.
+ * @param[in] last наибольшая длина начала слова.
+ */
+void Lyndon::split(
+        const uint_fast64_t word, const uint_fast8_t t, const uint_fast8_t p, const uint_fast8_t last
+) noexcept {
+    if (t > last) {
+        tasks.push_back(Task{word, t, p});
+        return;
+    }
+    const uint_fast64_t bit = 1ull << static_cast<uint_fast8_t>(degree - t);
+    const bool repeat = (word >> static_cast<uint_fast8_t>(degree - t + p)) & 1u;
+    split(repeat ? word | bit : word, t + 1, p, last);
+    if (!repeat) { split(word | bit, t + 1, t, last); }
+}
+
+/**
+ * Продолжает перебор предожерелий от заданного начала. Слово k длины n
+ * является словом Линдона тогда и только тогда, когда его период равен n,
+ * тогда оно наименьшее в своём циклотомическом классе {k, 2k, 4k, ...}
+ * по модулю 2^n - 1 и элемент a^k поля, где a - корень примитивного
+ * многочлена, имеет степень n. Его сопряжённые a^(2^i k) - корни одного
+ * и того же неприводимого многочлена, поэтому разные слова Линдона
+ * дают разные многочлены, а всего их столько же, сколько неприводимых.
+ * Элемент a^k вычисляется вместе со словом: при установке бита i
+ * он умножается на a^(2^i).
+ * @param[in,out] w рабочий поток.
+ * @param[in] m умножение по модулю примитивного многочлена.
+ * @param[in] word первые t - 1 букв слова.
+ * @param[in] t номер следующей буквы, от 1.
+ * @param[in] p период начала слова.
+ * @param[in] beta a^word.
+ */
+void Lyndon::walk(
+        Worker &w, const Clmul &m, const uint_fast64_t word,
+        const uint_fast8_t t, const uint_fast8_t p, const uint_fast64_t beta
+) noexcept {
+    const uint_fast8_t n = degree;
+    if (t > n) {
+        if (p != n) { return; }
+        // слово дополнения задаёт b^(-1) и отражённый многочлен,
+        // из каждой пары обрабатывается слово с меньшим ожерельем
+        const uint_fast64_t mask = (1ull << n) - 1ull;
+        uint_fast64_t r = ~word & mask, least = r;
+        if (r < word) { return; }
+        for (uint_fast8_t k = 1; k < n; ++k) {
+            r = ((r << 1u) | (r >> static_cast<uint_fast8_t>(n - 1u))) & mask;
+            if (r < word) { return; }
+            if (r < least) { least = r; }
+        }
+        const uint_fast64_t q = minimal(m, beta);
+        w.out.push_back(q);
+        w.count += least == word ? 1 : 2;
+        if (least != word) { w.out.push_back(Polynomial(q).Reverse(n)); }
+        if (w.out.size() >= batch) { flush(w); }
+        return;
+    }
+    const uint_fast8_t i = n - t;
+    const bool repeat = (word >> static_cast<uint_fast8_t>(i + p)) & 1u;
+    const uint_fast64_t next = m.Mul(beta, powers[i]);
+    walk(w, m, repeat ? word | (1ull << i) : word, t + 1, p, repeat ? next : beta);
+    if (!repeat) { walk(w, m, word | (1ull << i), t + 1, t, next); }
+}
+
+/**
+ * Находит многочлен, неприводимый вместе с минимальным многочленом
+ * элемента b степени n. Последовательность s_j = Tr(b^j) линейна
+ * и её минимальный многочлен совпадает с минимальным многочленом b,
+ * поэтому его находит алгоритм Берлекампа-Месси по 2n членам.
+ * След не меняется при возведении в квадрат, поэтому s_2j = s_j
+ * и умножение в поле нужно только для нечётных членов.
+ * Многочлен связи, который строит алгоритм, - отражённый минимальный
+ * многочлен, т.е. минимальный многочлен b^(-1).
+ * Члены последовательности хранятся в окне, где бит i - s_(j-i),
+ * поэтому невязка - чётность конъюнкции окна и многочлена связи.
+ * @param[in] m умножение по модулю примитивного многочлена.
+ * @param[in] b элемент поля степени n.
+ * @return минимальный многочлен b^(-1).
+ */
+[[nodiscard]]
+uint_fast64_t Lyndon::minimal(const Clmul &m, const uint_fast64_t b) const noexcept {
+    const uint_fast8_t n = degree;
+    bool s[2 * 63 + 2];
+    s[0] = trace & 1u;
+    // нечётные степени вычисляются двумя независимыми цепочками
+    // умножений на b^4, чтобы задержки умножений перекрывались
+    const uint_fast64_t b2 = m.Sqr(b), b4 = m.Sqr(b2);
+    uint_fast64_t x = b, y = m.Mul(b, b2);
+    for (uint_fast8_t j = 1; j < 2 * n; j += 4) {
+        s[j] = __builtin_parityll(x & trace);
+        s[j + 2] = __builtin_parityll(y & trace);
+        x = m.Mul(x, b4);
+        y = m.Mul(y, b4);
+    }
+    for (uint_fast8_t j = 2; j < 2 * n; j += 2) { s[j] = s[j / 2]; }
+
+    uint_fast64_t c = 1, prev = 1, window = 0, t;
+    uint_fast8_t length = 0, shift = 1;
+    for (uint_fast8_t j = 0; j < 2 * n; ++j) {
+        window = (window << 1u) | static_cast<uint_fast64_t>(s[j]);
+        if (!__builtin_parityll(c & window)) {
+            ++shift;
+            continue;
+        }
+        t = c;
+        c ^= prev << shift;
+        if (2 * length > j) {
+            ++shift;
+            continue;
+        }
+        length = j + 1 - length;
+        prev = t;
+        shift = 1;
+    }
+    return c;
+}
+
+/**
+ * Передаёт накопленные потоком многочлены в callback.
+ * Вызовы callback из разных потоков не пересекаются во времени.
+ * @param[in,out] w рабочий поток.
+ */
+void Lyndon::flush(Worker &w) noexcept {
+    if (w.out.empty()) { return; }
+    pthread_mutex_lock(&output);
+    for (auto p : w.out) { (*callback)(p); }
+    pthread_mutex_unlock(&output);
+    w.out.clear();
+}
+
+/**
+ * Цикл рабочего потока: забирает очередное начало слова и перебирает
+ * все слова Линдона с этим началом.
+ * @param arg экземпляр Worker, принадлежащий данному потоку.
+ * @return nullptr после окончания перебора.
+ */
+void *Lyndon::work(void *arg) noexcept {
+    auto &w = *static_cast<Worker *>(arg);
+    auto &e = *w.owner;
+    const Clmul m(e.modulus, e.degree);
+    for (std::size_t k = e.taken++; k < e.tasks.size(); k = e.taken++) {
+        const Task &task = e.tasks[k];
+        uint_fast64_t beta = 1;
+        for (uint_fast8_t i = 0; i < e.degree; ++i) {
+            if ((task.word >> i) & 1u) { beta = m.Mul(beta, e.powers[i]); }
+        }
+        e.walk(w, m, task.word, task.next, task.period, beta);
+    }
+    e.flush(w);
+    return nullptr;
+}
+
+/**
+ * Находит все неприводимые многочлены заданной степени как минимальные
+ * многочлены элементов поля GF[2^n], по одному на каждое слово Линдона
+ * длины n (см. walk). В отличие от полного перебора (см. Enumerator),
+ * время пропорционально числу неприводимых многочленов (около 2^n / n),
+ * а не числу кандидатов 2^(n-1): на каждый многочлен приходится около 2n
+ * умножений в поле. Поле строится по наименьшему примитивному многочлену
+ * степени n (см. Polynomial::First). Перебор делится на части по первым
+ * буквам слова, которые потоки разбирают по очереди; вызывающий поток
+ * также участвует в переборе.
+ * Многочлены передаются в callback порциями по мере нахождения, в произвольном
+ * порядке; callback вызывается из рабочих потоков, но никогда одновременно.
+ * @param[in] d степень многочленов, от 1 до 63.
+ * @param[in] cb получает каждый неприводимый многочлен ровно один раз.
+ * @return число неприводимых многочленов, 0 если degree задан некорректно.
+ */
+uint_fast64_t Lyndon::Enumerate(
+        const uint_fast8_t d, const std::function<void(uint_fast64_t)> &cb
+) noexcept {
+    if (d == 0 || d > 63) { return 0; }
+    if (d == 1) {
+        // x - минимальный многочлен нуля, который не является степенью a
+        cb(2ull);
+        cb(3ull);
+        return 2;
+    }
+    degree = d;
+    callback = &cb;
+    modulus = Polynomial<>::First(d, true);
+
+    const Clmul m(modulus, d);
+    powers.resize(d);
+    powers[0] = 2;
+    for (uint_fast8_t i = 1; i < d; ++i) { powers[i] = m.Sqr(powers[i - 1]); }
+    // бит i - след x^i, Tr(b) = b + b^2 + ... + b^(2^(n-1))
+    trace = 0;
+    for (uint_fast8_t i = 0; i < d; ++i) {
+        uint_fast64_t b = 1ull << i, sum = 0;
+        for (uint_fast8_t k = 0; k < d; ++k, b = m.Sqr(b)) { sum ^= b; }
+        trace |= sum << i;
+    }
+
+    tasks.clear();
+    split(0, 1, 1, d < depth ? d : depth);
+    taken = 0;
+    workers.assign(threadsNum, Worker{this, pthread_t(), 0, {}});
+    // если поток не удалось создать, его долю разберут остальные
+    std::vector<bool> started(threadsNum, false);
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        started[i] = pthread_create(&workers[i].thread, nullptr, &work, &workers[i]) == 0;
+    }
+    work(&workers[0]);
+
+    uint_fast64_t res = workers[0].count;
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        if (started[i]) { pthread_join(workers[i].thread, nullptr); }
+        res += workers[i].count;
+    }
+    workers.clear();
+    tasks.clear();
+    callback = nullptr;
+    return res;
+}
@@ -0,0 +1,66 @@
+/**
+ * @file    Lyndon.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_LYNDON_HPP
+#define BERLEKAMP_LYNDON_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include <pthread.h>
+#include "Clmul.hpp"
+
+class Lyndon {
+    /// начало слова Линдона, с которого продолжает перебор рабочий поток
+    struct Task {
+        uint_fast64_t word;
+        uint_fast8_t next;
+        uint_fast8_t period;
+    };
+
+    struct Worker {
+        Lyndon *owner;
+        pthread_t thread;
+        uint_fast64_t count;
+        std::vector<uint_fast64_t> out;
+    };
+
+    std::vector<Task> tasks;
+    std::vector<Worker> workers;
+    std::vector<uint_fast64_t> powers;
+    std::atomic<std::size_t> taken;
+    pthread_mutex_t output;
+    const std::function<void(uint_fast64_t)> *callback;
+    uint_fast64_t modulus;
+    uint_fast64_t trace;
+    uint_fast8_t degree;
+    uint_fast8_t threadsNum;
+
+    static
+    void *work(void *) noexcept;
+
+    void split(uint_fast64_t, uint_fast8_t, uint_fast8_t, uint_fast8_t) noexcept;
+
+    void walk(Worker &, const Clmul &, uint_fast64_t, uint_fast8_t, uint_fast8_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t minimal(const Clmul &, uint_fast64_t) const noexcept;
+
+    void flush(Worker &) noexcept;
+
+public:
+    explicit
+    Lyndon(uint_fast8_t = 0) noexcept;
+
+    uint_fast64_t Enumerate(uint_fast8_t, const std::function<void(uint_fast64_t)> &) noexcept;
+};
+
+#endif //BERLEKAMP_LYNDON_HPP
@@ -7,250 +7,560 @@
  * @url     https://github.com/vadimpiven/irrpolygf2
  */
 
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
+#include "Clmul.hpp"
+#include "Rank.hpp"
 #include "Polynomial.hpp"
+#include "Stats.hpp"
 
 /**
- * Создаёт новый многочлен над полем GF[2^n], n = 0,...,63.
- * @param[in] val представляет многочлен как 64-битное целое число,
- * где представлению P(x) = a + b*x + c*x^2 соответствует число
- * с побитовым представлением ...cba, здесь a, b, c = 0 или 1,
- * т.к. коэффициенты многочлена лежат в поле GF[2].
+ * @param p1 делимое.
+ * @param p2 делитель, не равный нулю.
+ * @return частное от деления многочлена p1 на многочлен p2.
  */
-Polynomial::Polynomial(const uint_fast64_t val) noexcept : val(val) {}
+[[nodiscard]]
+uint_fast64_t Polynomial<1>::quotient(uint_fast64_t p1, const uint_fast64_t p2) noexcept {
+    const uint_fast8_t degree = deg(p2);
+    uint_fast64_t q = 0;
+    for (uint_fast8_t i = deg(p1); i >= degree && p1 != 0; i = deg(p1)) {
+        q |= 1ull << static_cast<uint_fast8_t>(i - degree);
+        p1 ^= (p2 << static_cast<uint_fast8_t>(i - degree));
+    }
+    return q;
+}
 
 /**
- * @return текущий многочлен, представленный как 64-битное целое число.
+ * Возводит многочлен в степень по модулю, двигаясь от старших бит показателя.
+ * @param[in] m умножение по модулю многочлена степени n.
+ * @param[in] a основание, многочлен степени меньше n.
+ * @param[in] e показатель степени.
+ * @return a^e по модулю многочлена.
  */
-[[nodiscard]]
-uint_fast64_t Polynomial::Get() const noexcept {
-    return val;
+[[nodiscard]] static
+uint_fast64_t power(const Clmul &m, const uint_fast64_t a, const uint_fast64_t e) noexcept {
+    uint_fast64_t res = 1;
+    for (uint_fast8_t i = e ? 64u - __builtin_clzll(e) : 0; i-- > 0;) {
+        res = m.Sqr(res);
+        if ((e >> i) & 1ull) { res = m.Mul(res, a); }
+    }
+    return res;
+}
+
+/**
+ * @param[in] p многочлен, являющийся полным квадратом.
+ * @return многочлен, квадрат которого равен p: над полем GF[2]
+ * (a + b*x^2)^2 = a + b*x^4, поэтому остаются только чётные коэффициенты.
+ */
+[[nodiscard]] static
+uint_fast64_t squareRoot(const uint_fast64_t p) noexcept {
+    uint_fast64_t res = 0;
+    for (uint_fast8_t i = 0; i < 32; ++i) {
+        res |= ((p >> (2u * i)) & 1ull) << i;
+    }
+    return res;
 }
 
 /**
- * Вычисляет производную многочлена над полем GF[2].
- * @return многочлен, являющийся производной данного.
+ * Вычисляет порядок многочлена без кратных множителей, все неприводимые
+ * множители которого имеют одну и ту же степень k. Порядок каждого из них,
+ * а значит и их произведения, делит 2^k - 1, поэтому начиная с 2^k - 1
+ * показатель делится на простые q из таблицы, пока x^(e/q) = 1.
+ * @param[in] g произведение различных неприводимых многочленов степени k.
+ * @param[in] k степень множителей, от 1 до 63.
+ * @return наименьшее e > 0, при котором x^e = 1 по модулю g.
  */
 [[nodiscard]]
-uint_fast64_t Polynomial::derivative() const noexcept {
-    return (val & 0xAA'AA'AA'AA'AA'AA'AA'AAull) >> 1ull;
+uint_fast64_t Polynomial<1>::period(const uint_fast64_t g, const uint_fast8_t k) noexcept {
+    const uint_fast8_t degree = deg(g);
+    const Clmul m(g, degree);
+    const uint_fast64_t x = mod(2, g, degree);
+    uint_fast64_t e = (1ull << k) - 1;
+    for (const uint_fast64_t q : mersenne[k]) {
+        if (q == 0) { break; }
+        while (e % q == 0 && power(m, x, e / q) == 1) { e /= q; }
+    }
+    return e;
 }
 
 /**
- * Определяет, являются ли два многочлена взаимно простыми.
- * @param[in] p1 первый многочлен, старшей степени.
- * @param[in] p2 второй многочлен, младшей степени.
- * @return не взаимно просты ли два проверяемых многочлена,
- * ведущее отрицание используется для уменьшения числа выполняемых операций.
+ * Выполняет построение матрицы Берлекампа и вычисление её ранга (см. Rank::Get).
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[out] M буфер под матрицу размером не менее degree элементов.
+ * @return ранг матрицы Берлекампа.
  */
 [[nodiscard]]
-uint_fast64_t Polynomial::gcd(
-        uint_fast64_t p1, uint_fast64_t p2
-) noexcept {
-    uint_fast64_t temp;
-    while (p2 != 0) {
-        temp = mod(p1, p2, deg(p2));
-        p1 = p2;
-        p2 = temp;
+uint_fast8_t Polynomial<1>::berlekampMatrixRank(
+        const uint_fast8_t degree, uint_fast64_t *const M
+) const noexcept {
+    BerlekampMatrix(degree, M);
+    return Rank::Get(M, degree);
+}
+
+/**
+ * @param[in] q натуральное число от 2 до 63.
+ * @return является ли q простым.
+ */
+[[nodiscard]] static
+bool prime(const uint_fast8_t q) noexcept {
+    for (uint_fast8_t k = 2; k * k <= q; ++k) {
+        if (q % k == 0) { return false; }
     }
-    return p1;
+    return true;
 }
 
 /**
- * Вычисляет степень многочлена, представленного как 64-битное число.
- * Для вычисления степени используется встроенная в процессоры архитектуры
- * AMD64 и ARM команда для подсчёта числа ведущих нулей в числе.
- * Поэтому данный код можно компилировать только с использованием GCC (Clang).
- * Степень многочлена находится вычитанием из 63 (максимальная возможная степень)
- * числа ведущих нулей. Например, если число ведущих нулей 0, значит
- * старший бит – единица, значит многочлен степени 63 = 63 - 0.
- * @param[in] p многочлен, степень от 0 до 63.
- * @return степень многочлена от 0 до 63.
+ * Проверка неприводимости алгоритмом Берлекампа (см. IsIrredusible).
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @param[out] buffer буфер размером не менее degree элементов.
+ * @return является ли данный многочлен неприводимым над полем GF[2].
  */
 [[nodiscard]]
-uint_fast8_t Polynomial::deg(const uint_fast64_t p) noexcept {
-    if (p == 0) { return 0; }
-    return static_cast<uint_fast8_t>
-    (63ull - __builtin_clzll(static_cast<unsigned long long>(p)));
+bool Polynomial<1>::berlekamp(
+        const uint_fast8_t degree, uint_fast64_t *const buffer
+) const noexcept {
+    STATS_CLOCK(t);
+    const auto pp = derivative();
+    STATS_LAP(t, Derivative, degree, 1, pp == 0);
+    if (pp == 0) { return false; }
+    const bool coprime = gcd(val, pp) == 1;
+    STATS_LAP(t, Gcd, degree, 1, !coprime);
+    if (!coprime) { return false; }
+    const bool full = berlekampMatrixRank(degree, buffer) == degree - 1;
+    STATS_LAP(t, Rank, degree, 1, !full);
+    return full;
 }
 
 /**
- * @param p1 делимое.
- * @param p2 делитель.
- * @param degree степень делителя.
- * @return многочлен p1 по модулю многочлена p2.
+ * Проверка неприводимости последовательным возведением x в квадрат.
+ * Вычисляются u_i = x^(2^i) (mod P(x)), i = 1,...,n.
+ * Многочлен x^(2^i) - x делится на все неприводимые многочлены, степень
+ * которых делит i, поэтому если gcd(u_i - x, P) != 1, то у P есть делитель
+ * степени не больше i. Первые шаги выполняются по алгоритму Бен-Ора:
+ * НОД считается на каждом шаге, т.к. большая часть случайных многочленов
+ * имеет делитель малой степени и отбрасывается сразу. Если шаги Бен-Ора
+ * дошли до n/2, то делителей степени не больше n/2 нет и многочлен неприводим.
+ * Иначе окончательный ответ даёт тест Рабина: P неприводим тогда и только тогда,
+ * когда u_n = x и gcd(u_(n/q) - x, P) = 1 для всех простых q, делящих n.
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @return является ли данный многочлен неприводимым над полем GF[2].
  */
 [[nodiscard]]
-uint_fast64_t Polynomial::mod(
-        uint_fast64_t p1, const uint_fast64_t p2, const uint_fast8_t degree
-) noexcept {
-    for (uint_fast8_t i = deg(p1); i >= degree && p1 != 0; i = deg(p1)) {
-        p1 ^= (p2 << static_cast<uint_fast8_t>(i - degree));
+bool Polynomial<1>::rabin(const uint_fast8_t degree) const noexcept {
+    // число шагов, на которых выполняется проверка Бен-Ора
+    static const uint_fast8_t benOr = 16;
+
+    if (degree == 1) { return true; }
+    if ((val & 1ull) == 0) { return false; } // делится на x
+    const uint_fast8_t half = degree / 2;
+    const uint_fast8_t steps = half < benOr ? half : benOr;
+    STATS_CLOCK(t);
+    uint_fast64_t u = 2; // x
+    uint_fast8_t i = 1;
+    // пока степень x^(2^i) меньше n, приводить его по модулю не нужно
+    for (; i <= steps && (1ull << i) < degree; ++i) {
+        u = 1ull << (1ull << i);
+        if (gcd(val, u ^ 2ull) != 1) {
+            STATS_LAP(t, BenOr, degree, 1, 1);
+            return false;
+        }
     }
-    return p1;
+    const Clmul m(val, degree);
+    for (; i <= steps; ++i) {
+        u = m.Sqr(u);
+        if (gcd(val, u ^ 2ull) != 1) {
+            STATS_LAP(t, BenOr, degree, 1, 1);
+            return false;
+        }
+    }
+    STATS_LAP(t, BenOr, degree, 1, 0);
+    if (steps == half) { return true; }
+
+    for (; i <= degree; ++i) {
+        u = m.Sqr(u);
+        if (i < degree && degree % i == 0 && prime(degree / i) &&
+            gcd(val, u ^ 2ull) != 1) {
+            STATS_LAP(t, Rabin, degree, 1, 1);
+            return false;
+        }
+    }
+    STATS_LAP(t, Rabin, degree, 1, u != 2);
+    return u == 2;
 }
 
 /**
- * Создаёт 128-битное число из 64-битного.
- * @param[in] p 64-битное число.
+ * Произведение нескольких неприводимых многочленов малой степени,
+ * умещающееся в 64 бита, и умножение по его модулю.
  */
-Polynomial::uint_fast128_t::uint_fast128_t(
-        const uint_fast64_t p
-) noexcept : h(0), l(p) {}
+struct SmallFactors {
+    uint_fast64_t product; ///< произведение многочленов
+    uint_fast64_t fold;    ///< x^(2D) по модулю product, D - степень product
+    uint_fast8_t degree;   ///< степень произведения D
+    uint_fast8_t bound;    ///< наибольшая степень сомножителя
+    Clmul m;               ///< приведение по модулю product
+};
 
 /**
- * Создаёт 128-битное число из двух 64-битных.
- * @param[in] ph старшие 64 бита.
- * @param[in] pl младшие 64 бита.
+ * Строит при первом обращении произведения всех неприводимых многочленов
+ * степени от 1 до 8, кроме x (их 69, суммарная степень 470).
+ * Многочлены степени до 4 собраны в одно слово степени 21, т.к. они
+ * отсекают большую часть кандидатов, а стоимость НОД растёт со степенью.
+ * Перед ним стоят слова с делителями степени до 2 и до 3 для проверок
+ * с меньшей границей, каждая проверка использует только одно из этих
+ * трёх слов. Многочлены каждой следующей степени поровну делятся
+ * на минимальное число слов степени не больше 63.
+ * @return слова в порядке возрастания наибольшей степени сомножителя.
  */
-Polynomial::uint_fast128_t::uint_fast128_t(
-        const uint_fast64_t ph, const uint_fast64_t pl
-) noexcept : h(ph), l(pl) {}
+[[nodiscard]] static
+const std::vector<SmallFactors> &smallFactors() noexcept {
+    static const std::vector<SmallFactors> res = [] {
+        std::vector<SmallFactors> words;
+        std::vector<uint_fast64_t> irr;
+        const auto flush = [&words, &irr](const uint_fast8_t bound, std::size_t parts) {
+            for (std::size_t i = 0; i < parts; ++i) {
+                uint_fast64_t product = 1;
+                for (std::size_t j = irr.size() * i / parts; j < irr.size() * (i + 1) / parts; ++j) {
+                    product = static_cast<uint_fast64_t>(Clmul::Product(product, irr[j]));
+                }
+                const uint_fast8_t degree = 63u - __builtin_clzll(product);
+                uint_fast64_t fold = 0;
+                if (2 * degree < 64) {
+                    fold = 1ull << (2u * degree);
+                    for (uint_fast8_t k = 63u - __builtin_clzll(fold); k >= degree; --k) {
+                        if ((fold >> k) & 1ull) { fold ^= product << (k - degree); }
+                    }
+                }
+                words.push_back({product, fold, degree, bound, Clmul(product, degree)});
+            }
+            irr.clear();
+        };
+        for (uint_fast8_t d = 1; d <= 8; ++d) {
+            for (uint_fast64_t p = (1ull << d) | 1ull; p < (2ull << d); p += 2) {
+                if (Polynomial(p).IsIrredusible(d, Polynomial<>::Method::Rabin)) { irr.push_back(p); }
+            }
+            if (d < 4) {
+                // копия уже найденных делителей войдёт в следующее слово
+                const std::vector<uint_fast64_t> low = irr;
+                if (d > 1) { flush(d, 1); }
+                irr = low;
+            } else {
+                flush(d, (irr.size() * d + 62) / (63 / d * d));
+            }
+        }
+        return words;
+    }();
+    return res;
+}
 
 /**
- * Вычисляет степень многочлена над GF[2], представленного 128-битным числом.
- * @return степень входного многочлена от 0 до 127.
+ * Определяет, взаимно просты ли многочлены, бинарным алгоритмом:
+ * множители x отбрасываются сдвигом, из большего многочлена вычитается
+ * меньший. В отличие от gcd не требует деления с остатком.
+ * @param[in] p1 многочлен, не делящийся на x.
+ * @param[in] p2 второй многочлен.
+ * @return взаимно просты ли многочлены.
  */
-[[nodiscard]]
-uint_fast8_t Polynomial::uint_fast128_t::deg() const noexcept {
-    if (h == 0) {
-        if (l == 0) { return 0; }
-        return static_cast<uint_fast8_t>
-        (63ull - __builtin_clzll(static_cast<unsigned long long>(l)));
+[[nodiscard]] static
+bool coprime(uint_fast64_t p1, uint_fast64_t p2) noexcept {
+    uint_fast64_t lo;
+    while (p2 != 0) {
+        p2 >>= static_cast<uint_fast8_t>(__builtin_ctzll(p2));
+        // больший минус меньший равен p1 ^ p2 при любом их порядке,
+        // поэтому ветвление остаётся только в выборе меньшего (cmov)
+        lo = p1 < p2 ? p1 : p2;
+        p2 ^= p1;
+        p1 = lo;
     }
-    return static_cast<uint_fast8_t>
-    (127ull - __builtin_clzll(static_cast<unsigned long long>(h)));
+    return p1 == 1;
 }
 
 /**
- * Выполняет побитовый сдвиг 128-битного числа.
- * @param[in] n на сколько бит сдвинуть.
- * @return новое число, представляющее из себя сдвинутое старое.
+ * Быстрая отбраковка кандидатов перед построением матрицы Берлекампа
+ * или возведением в квадрат: определяет, есть ли у многочлена
+ * неприводимый делитель степени не больше min(bound, n/2).
+ * Делимость на x и x+1 (половина случайных многочленов) проверяется
+ * по младшему биту и чётности числа ненулевых коэффициентов,
+ * затем многочлен приводится по модулю каждого слова из smallFactors
+ * (редукция Барретта, см. Clmul; для слов степени D < 32 старшая часть
+ * многочлена предварительно умножается на x^(2D) по модулю слова,
+ * пока степень не станет меньше 2D)
+ * и проверяется взаимная простота остатка и слова.
+ * Каждая проверка отсекает сразу все делители из слова, поэтому в среднем
+ * хватает одной-двух проверок, а не одной на каждую степень, как в rabin.
+ * Делители степени больше n/2 не проверяются: иначе неприводимый
+ * многочлен малой степени совпал бы с одним из сомножителей.
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[in] bound наибольшая проверяемая степень делителя, от 0 до 8,
+ * 0 отключает проверку.
+ * @return найден ли делитель, т.е. многочлен заведомо приводим.
  */
 [[nodiscard]]
-Polynomial::uint_fast128_t Polynomial::uint_fast128_t::operator<<(
-        const uint_fast8_t n
-) const noexcept {
-    auto res = uint_fast128_t(h << n, n >= 64 ? 0 : l << n);
-    if (deg() + n > 63u) { res.h |= (n > 64u) ? (l << (n - 64u)) : (l >> (64u - n)); }
-    return res;
+bool Polynomial<1>::HasSmallFactor(const uint_fast8_t degree, uint_fast8_t bound) const noexcept {
+    if (bound > degree / 2) { bound = degree / 2; }
+    if (bound == 0) { return false; }
+    if ((val & 1ull) == 0 || (__builtin_popcountll(val) & 1) == 0) { return true; }
+    if (bound == 1) { return false; }
+    const auto &words = smallFactors();
+    uint_fast64_t r;
+    // из слов с делителями степени до 2, до 3 и до 4 берётся одно
+    for (auto w = words.begin() + (bound < 4 ? bound : 4) - 2; w != words.end(); ++w) {
+        if (w->bound > bound) { break; }
+        r = val;
+        // для слов степени от 21 хватает одного шага, для меньших нужно несколько
+        while (w->fold != 0 && deg(r) >= 2 * w->degree) {
+            r = static_cast<uint_fast64_t>(Clmul::Product(r >> (2u * w->degree), w->fold)) ^
+                (r & ((1ull << (2u * w->degree)) - 1));
+        }
+        if (!coprime(w->product, w->m.Reduce(r))) { return true; }
+    }
+    return false;
 }
 
 /**
- * Реализует операцию XOR.
- * @param[in] p 128-битное число, с которым необходимо сложить данное по модулю 2.
+ * Проверка порядка во время работы программы (см. HasMaximalOrder):
+ * возведение в степень выполняется умножением по модулю (см. Clmul).
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @return имеет ли многочлен порядок 2^n - 1, если он неприводим.
  */
-void Polynomial::uint_fast128_t::operator^=(const uint_fast128_t p) noexcept {
-    h ^= p.h;
-    l ^= p.l;
+[[nodiscard]]
+bool Polynomial<1>::maximalOrder(const uint_fast8_t degree) const noexcept {
+    const Clmul m(val, degree);
+    const uint_fast64_t x = mod(2, val, degree);
+    const uint_fast64_t e = (1ull << degree) - 1;
+    for (const uint_fast64_t q : mersenne[degree]) {
+        if (q == 0) { break; }
+        if (power(m, x, e / q) == 1) { return false; }
+    }
+    return true;
 }
 
 /**
- * @return младшие 64 бита 128-битного числа (предполагается, что старшие пусты).
+ * Разложение на множители без кратных корней: f = prod a_i^i, где a_i
+ * попарно взаимно просты и не имеют кратных множителей.
+ * Для c = gcd(f, f') многочлен w = f / c - произведение всех неприводимых
+ * множителей f, кратность которых не делится на 2, на каждом шаге
+ * y = gcd(w, c) оставляет множители большей кратности, а w / y - кратности i.
+ * Над полем GF[2] множители чётной кратности дают нулевую производную,
+ * поэтому остаток c - полный квадрат, из которого извлекается корень,
+ * и разложение повторяется с удвоенными кратностями.
+ * @param[in] f многочлен, отличный от нуля.
+ * @return многочлены a_i степени больше 0 и их кратности.
  */
 [[nodiscard]]
-uint_fast64_t Polynomial::uint_fast128_t::get() const noexcept {
-    return l;
+Polynomial<1>::Factors Polynomial<1>::squareFree(uint_fast64_t f) noexcept {
+    Factors res;
+    uint_fast64_t c, w, y, z;
+    uint_fast8_t scale = 1, i;
+    while (deg(f) > 0) {
+        c = gcd(f, Polynomial(f).derivative());
+        w = quotient(f, c);
+        for (i = 1; deg(w) > 0; ++i) {
+            y = gcd(w, c);
+            z = quotient(w, y); // множители кратности i * scale
+            if (deg(z) > 0) { res.emplace_back(z, i * scale); }
+            w = y;
+            c = quotient(c, y);
+        }
+        // оставшаяся часть - полный квадрат
+        f = squareRoot(c);
+        scale *= 2;
+    }
+    return res;
 }
 
 /**
- * @return является ли данное 128-битное число нулём.
+ * Разложение по степеням множителей: многочлен x^(2^k) - x делится на все
+ * неприводимые многочлены, степень которых делит k, поэтому
+ * g_k = gcd(r, x^(2^k) - x) после деления r на g_1, ..., g_(k-1) - произведение
+ * всех неприводимых множителей r степени k. Когда степень остатка становится
+ * меньше 2k, он сам неприводим. Возведение в квадрат по модулю r (см. Clmul).
+ * @param[in] r многочлен без кратных множителей.
+ * @return многочлены g_k степени больше 0 и степени k их неприводимых множителей.
  */
 [[nodiscard]]
-bool Polynomial::uint_fast128_t::notZero() const noexcept {
-    return l != 0 || h != 0;
+Polynomial<1>::Factors Polynomial<1>::distinctDegree(uint_fast64_t r) noexcept {
+    Factors res;
+    if (deg(r) == 0) { return res; }
+    uint_fast64_t u = mod(2, r, deg(r)), g;
+    Clmul m(r, deg(r));
+    for (uint_fast8_t k = 1; 2 * k <= deg(r); ++k) {
+        u = m.Sqr(u); // x^(2^k) по модулю r
+        g = gcd(r, u ^ 2ull);
+        if (deg(g) == 0) { continue; }
+        res.emplace_back(g, k);
+        r = quotient(r, g);
+        if (deg(r) == 0) { break; }
+        m = Clmul(r, deg(r));
+        u = mod(u, r, deg(r));
+    }
+    if (deg(r) > 0) { res.emplace_back(r, deg(r)); }
+    return res;
 }
 
 /**
- * @param p1 делимое.
- * @param p2 делитель.
- * @param degree степень делителя.
- * @return многочлен p1 по модулю многочлена p2.
+ * Находит базис пространства решений v * M = 0 для матрицы Берлекампа
+ * M = Q - E (см. BerlekampMatrix): v(x)^2 = v(x) по модулю многочлена
+ * тогда и только тогда, когда коэффициенты v лежат в этом пространстве.
+ * Приведение к ступенчатому виду выполняется вместе с записью того,
+ * какие исходные строки вошли в каждую строку, поэтому ранг и базис
+ * получаются одним проходом по той же матрице.
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @param[in,out] M матрица Берлекампа, разрушается.
+ * @param[out] basis буфер не менее чем на degree элементов под базис.
+ * @return размерность пространства, равная числу неприводимых множителей
+ * многочлена без кратных множителей (degree - ранг M).
  */
 [[nodiscard]]
-uint_fast64_t Polynomial::mod(
-        uint_fast128_t p1, const uint_fast128_t p2, const uint_fast8_t degree
+uint_fast8_t Polynomial<1>::nullSpace(
+        const uint_fast8_t degree, uint_fast64_t *const M, uint_fast64_t *const basis
 ) noexcept {
-    for (uint_fast8_t i = p1.deg(); i >= degree && p1.notZero(); i = p1.deg()) {
-        p1 ^= (p2 << static_cast<uint_fast8_t>(i - degree));
+    uint_fast64_t tag[63];
+    bool used[63] = {};
+    uint_fast8_t i, j, count = 0;
+    for (i = 0; i < degree; ++i) { tag[i] = 1ull << i; }
+    for (uint_fast8_t c = 0; c < degree; ++c) {
+        for (i = 0; i < degree && (used[i] || !((M[i] >> c) & 1ull)); ++i);
+        if (i == degree) { continue; }
+        used[i] = true;
+        for (j = 0; j < degree; ++j) {
+            if (j != i && ((M[j] >> c) & 1ull)) {
+                M[j] ^= M[i];
+                tag[j] ^= tag[i];
+            }
+        }
     }
-    return p1.get();
+    for (i = 0; i < degree; ++i) {
+        if (!used[i]) { basis[count++] = tag[i]; }
+    }
+    return count;
 }
 
 /**
- * Выполняет построение матрицы Берлекампа и вычисление её ранга.
- * Строится матрица M[nxn], где строки - коэффициенты многочлена x^(ip) (mod P(x)),
- * где p - двойка, 0 < i < n, P(x) - текущий многочлен над полем GF[2] степени n.
- * Подробное описание и пример расчёта можно найти в статье
- * "A Formalization of Berlekamp’s Factorization Algorithm" по ссылке
- * http://www21.in.tum.de/~nipkow/Isabelle2016/Isabelle2016_6.pdf (стр. 3-4).
- * Матрица строится в зеркально отражённом виде для оптимизации хранимых данных.
- * Затем из матрицы вычитается единичная матрица.
- * В конце вычисляется ранг получившейся матрицы.
- * @param[in] degree степень текущего многочлена, от 1 до 63,
- * не проверяется корректность для уменьшания числа выполняемых операций.
- * @return ранг матрицы Берлекампа.
+ * Вычисляет порядок (период) произвольного многочлена f с ненулевым
+ * свободным членом - наименьшее e > 0, при котором f делит x^e - 1.
+ * Многочлен раскладывается на множители без кратных корней (см. squareFree),
+ * находятся произведение r различных неприводимых множителей и наибольшая
+ * кратность t. Затем r разбивается на произведения множителей одной
+ * степени k (см. distinctDegree), порядок каждого находится по таблице
+ * делителей 2^k - 1. Порядок f равен НОК найденных порядков, умноженному
+ * на наименьшую степень двойки, не меньшую t.
+ * @return порядок многочлена, 0 если многочлен делится на x или равен нулю.
  */
 [[nodiscard]]
-uint_fast8_t Polynomial::berlekampMatrixRank(const uint_fast8_t degree) const noexcept {
-    std::vector<uint_fast64_t> M(degree);
-    uint_fast64_t temp;
-    uint_fast8_t i, j, k;
-    bool flag;
+uint_fast64_t Polynomial<1>::Order() const noexcept {
+    if ((val & 1ull) == 0) { return 0; }
 
-    for (i = 0; i < degree; ++i) {
-        // x ^ ip, p = 2
-        temp = i < 32 ?
-               // случай, когда x ^ ip влезает в 64 бита
-               mod(1ull << static_cast<uint_fast8_t>(i * 2), val, degree) :
-               // случай, когда x ^ ip не влезает в 64 бита
-               mod(uint_fast128_t(1ull) << static_cast<uint_fast8_t>(i * 2),
-                   uint_fast128_t(val), degree);
-        M[i] = temp ^ (1ull << i); // M -= E (mod 2)
+    uint_fast64_t r = 1, order = 1, multiplicity = 1, scale, z;
+    for (const auto &[a, i] : squareFree(val)) {
+        r = static_cast<uint_fast64_t>(Clmul::Product(r, a));
+        if (i > multiplicity) { multiplicity = i; }
     }
+    for (const auto &[g, k] : distinctDegree(r)) {
+        z = period(g, k);
+        order = order / std::gcd(order, z) * z;
+    }
+    // кратный множитель a^t увеличивает порядок в 2^s раз, где 2^s >= t
+    for (scale = 1; scale < multiplicity; scale <<= 1u);
+    return order * scale;
+}
 
-    // приведение матрицы к ступенчатому виду
-    for (i = k = 0, temp = 1; i < degree && k < degree; ++k, temp <<= 1ull) {
-        flag = M[i] & temp;
-        for (j = i + 1; j < degree; ++j) {
-            if (M[j] & temp) {
-                switch (flag) { // ~if-else
-                case false: // swap
-                    M[i] ^= M[j];
-                    M[j] = M[i] ^ M[j];
-                    M[i] ^= M[j];
-                    flag = true;
-                    continue;
-                default: // Mj -= Mi
-                    M[j] ^= M[i];
+/**
+ * Раскладывает многочлен на неприводимые множители алгоритмом Берлекампа.
+ * Сначала выделяются множители без кратных корней (см. squareFree).
+ * Для каждого из них один раз строится матрица Берлекампа и находится
+ * базис её нулевого пространства (см. nullSpace), размерность которого
+ * равна числу неприводимых множителей: если она равна 1, множитель
+ * неприводим. Иначе множитель разбивается по степеням (см. distinctDegree),
+ * и каждое произведение множителей одной степени k расщепляется НОДами
+ * с векторами базиса: для v из базиса gcd(h, v) - нетривиальный делитель h,
+ * если v различает какие-то два множителя h, а базис различает любые два.
+ * @return неприводимые множители и их кратности в порядке возрастания
+ * множителей, пустой список для многочленов 0 и 1.
+ */
+[[nodiscard]]
+Polynomial<1>::Factors Polynomial<1>::Factor() const noexcept {
+    Factors res;
+    if (val == 0) { return res; }
+    uint_fast64_t M[63], basis[63], h, a;
+    std::vector<uint_fast64_t> parts;
+    uint_fast8_t n, count, i;
+    std::size_t j;
+    for (const auto &[s, multiplicity] : squareFree(val)) {
+        n = deg(s);
+        Polynomial(s).BerlekampMatrix(n, M);
+        count = nullSpace(n, M, basis);
+        if (count == 1) {
+            res.emplace_back(s, multiplicity);
+            continue;
+        }
+        for (const auto &[g, k] : distinctDegree(s)) {
+            parts.assign(1, g);
+            // базисный вектор 1 не расщепляет ни один множитель
+            for (i = 0; i < count && parts.size() < deg(g) / k; ++i) {
+                if (basis[i] == 1) { continue; }
+                for (j = 0; j < parts.size(); ++j) {
+                    h = parts[j];
+                    if (deg(h) == k) { continue; }
+                    a = gcd(h, mod(basis[i], h, deg(h)));
+                    if (deg(a) == 0 || deg(a) == deg(h)) { continue; }
+                    parts[j] = a;
+                    parts.push_back(quotient(h, a));
                 }
             }
+            for (const auto p : parts) { res.emplace_back(p, multiplicity); }
         }
-        i += flag;
     }
-    return i;
+    std::sort(res.begin(), res.end());
+    return res;
 }
 
 /**
- * Определяет, является ли данный многочлен степени n неприводимым в поле GF[2].
- * Для определения неприводимости используется алгоритм Берлекампа.
- * Первый шаг - вычисление производной данного многочлена. Если производная
- * равна нулю, то многочлен является степенью какого-то другого многочлена,
- * то есть он приводим.
- * Второй шаг - поиск общих множителей многочлена и его производной.
- * Если общие множители (многочлены, а не числа) есть, т.е. многочлены
- * не взаимно просты, то f(x) делится на них, т.е. он не неприводим.
- * Третий шаг - простоение матрицы Берлекампа и вычисление её ранга.
- * Если ранг матрицы Берлекампа равен степени многочлена минус 1,
- * то многочлен неприводим.
- * @param[in] degree степень текущего многочлена, от 1 до 63,
- * не проверяется корректность для уменьшания числа выполняемых операций.
- * @return является ли данный многочлен степени n неприводимы над полем GF[2].
+ * Проверка неприводимости во время работы программы (см. IsIrredusible):
+ * матрица Берлекампа строится на стеке, а не в куче.
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @param[in] method алгоритм проверки.
+ * @return является ли данный многочлен неприводимым над полем GF[2].
+ */
+[[nodiscard]]
+bool Polynomial<1>::irreducible(const uint_fast8_t degree, Method method) const noexcept {
+    if (method == Method::Auto) { method = Choose(degree); }
+    if (method == Method::Rabin) { return rabin(degree); }
+    uint_fast64_t M[63];
+    return berlekamp(degree, M);
+}
+
+/**
+ * Проверка неприводимости во время работы программы с матрицей
+ * Берлекампа в переданном буфере (см. IsIrredusible).
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @param[out] buffer буфер размером не менее degree элементов.
+ * @param[in] method алгоритм проверки.
+ * @return является ли данный многочлен неприводимым над полем GF[2].
+ */
+[[nodiscard]]
+bool Polynomial<1>::irreducible(
+        const uint_fast8_t degree, uint_fast64_t *const buffer, Method method
+) const noexcept {
+    if (method == Method::Auto) { method = Choose(degree); }
+    if (method == Method::Rabin) { return rabin(degree); }
+    return berlekamp(degree, buffer);
+}
+
+/**
+ * Возвращает счётчики ступеней проверки неприводимости (см. Stats):
+ * сколько многочленов каждой степени дошло до ступени, сколько из них
+ * на ней отброшено и сколько тактов она заняла, суммарно по всем
+ * потокам процесса с момента запуска. Счётчики собираются только
+ * в сборке с BERLEKAMP_STATS, иначе проверка не несёт никаких
+ * накладных расходов, а таблица нулевая.
+ * @return таблица счётчиков Table[stage][degree].
  */
 [[nodiscard]]
-bool Polynomial::IsIrredusible(const uint_fast8_t degree) const noexcept {
-    auto pp = derivative();
-    return pp != 0 && gcd(val, pp) == 1 &&
-            berlekampMatrixRank(degree) == degree - 1;
+Stats::Table Polynomial<1>::GetStats() noexcept {
+    return Stats::Collect();
 }
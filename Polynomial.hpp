@@ -10,64 +10,832 @@
 #ifndef BERLEKAMP_POLYNOMIAL_HPP
 #define BERLEKAMP_POLYNOMIAL_HPP
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <utility>
+#include <vector>
+#include "Stats.hpp"
 
+template<std::size_t Words = 1>
 class Polynomial {
-    uint_fast64_t val;
+    static_assert(Words > 1, "64-bit polynomials are handled by Polynomial<1>");
+
+    using Bits = std::array<uint_fast64_t, Words>;
+
+    Bits val;
 
     [[nodiscard]]
-    uint_fast64_t derivative() const noexcept;
+    Bits derivative() const noexcept;
 
     [[nodiscard]] static
-    uint_fast64_t gcd(uint_fast64_t, uint_fast64_t) noexcept;
+    int_fast16_t deg(const Bits &) noexcept;
 
     [[nodiscard]] static
-    uint_fast8_t deg(uint_fast64_t) noexcept;
+    bool less(const Bits &, const Bits &) noexcept;
+
+    static
+    void shiftLeft(Bits &) noexcept;
+
+    static
+    void shiftRight(Bits &) noexcept;
 
     [[nodiscard]] static
-    uint_fast64_t mod(uint_fast64_t, uint_fast64_t, uint_fast8_t) noexcept;
+    bool coprime(Bits, Bits) noexcept;
 
-    class uint_fast128_t {
-        uint_fast64_t h;
-        uint_fast64_t l;
+    template<typename Stop>
+    [[nodiscard]]
+    uint_fast16_t berlekampMatrixRank(uint_fast16_t, const Stop &) const noexcept;
 
-    public:
-        explicit
-        uint_fast128_t(uint_fast64_t) noexcept;
+public:
+    explicit
+    Polynomial(uint_fast64_t) noexcept;
 
-        explicit
-        uint_fast128_t(uint_fast64_t, uint_fast64_t) noexcept;
+    explicit
+    Polynomial(const Bits &) noexcept;
+
+    [[nodiscard]]
+    bool IsIrredusible(uint_fast16_t) const noexcept;
 
-        [[nodiscard]]
-        uint_fast8_t deg() const noexcept;
+    template<typename Stop>
+    [[nodiscard]]
+    bool IsIrredusible(uint_fast16_t, const Stop &) const noexcept;
 
-        [[nodiscard]]
-        uint_fast128_t operator<<(uint_fast8_t) const noexcept;
+    [[nodiscard]]
+    Bits Get() const noexcept;
+};
 
-        void operator^=(uint_fast128_t) noexcept;
+template<>
+class Polynomial<1> {
+public:
+    enum class Method : uint_fast8_t {
+        Auto,      ///< выбирается по степени многочлена
+        Berlekamp, ///< ранг матрицы Берлекампа
+        Rabin      ///< последовательное возведение x в квадрат (Бен-Ор и Рабин)
+    };
 
-        [[nodiscard]]
-        uint_fast64_t get() const noexcept;
+    /// множители многочлена и их кратности
+    using Factors = std::vector<std::pair<uint_fast64_t, uint_fast8_t>>;
 
-        [[nodiscard]]
-        bool notZero() const noexcept;
+private:
+    // замеряет отдельные ступени проверки
+    friend class Benchmark;
+
+    /**
+     * Простые делители чисел 2^n - 1 для n = 0,...,63 (строка n, без повторов,
+     * список дополняется нулями). Порядок любого неприводимого многочлена
+     * степени n делит 2^n - 1, поэтому таблица позволяет проверять примитивность
+     * и находить порядок многочленов без разложения чисел во время работы.
+     */
+    static constexpr uint_fast64_t mersenne[64][11] = {
+        {}, // 2^0 - 1
+        {}, // 2^1 - 1
+        {3ull}, // 2^2 - 1
+        {7ull}, // 2^3 - 1
+        {3ull, 5ull}, // 2^4 - 1
+        {31ull}, // 2^5 - 1
+        {3ull, 7ull}, // 2^6 - 1
+        {127ull}, // 2^7 - 1
+        {3ull, 5ull, 17ull}, // 2^8 - 1
+        {7ull, 73ull}, // 2^9 - 1
+        {3ull, 11ull, 31ull}, // 2^10 - 1
+        {23ull, 89ull}, // 2^11 - 1
+        {3ull, 5ull, 7ull, 13ull}, // 2^12 - 1
+        {8191ull}, // 2^13 - 1
+        {3ull, 43ull, 127ull}, // 2^14 - 1
+        {7ull, 31ull, 151ull}, // 2^15 - 1
+        {3ull, 5ull, 17ull, 257ull}, // 2^16 - 1
+        {131071ull}, // 2^17 - 1
+        {3ull, 7ull, 19ull, 73ull}, // 2^18 - 1
+        {524287ull}, // 2^19 - 1
+        {3ull, 5ull, 11ull, 31ull, 41ull}, // 2^20 - 1
+        {7ull, 127ull, 337ull}, // 2^21 - 1
+        {3ull, 23ull, 89ull, 683ull}, // 2^22 - 1
+        {47ull, 178481ull}, // 2^23 - 1
+        {3ull, 5ull, 7ull, 13ull, 17ull, 241ull}, // 2^24 - 1
+        {31ull, 601ull, 1801ull}, // 2^25 - 1
+        {3ull, 2731ull, 8191ull}, // 2^26 - 1
+        {7ull, 73ull, 262657ull}, // 2^27 - 1
+        {3ull, 5ull, 29ull, 43ull, 113ull, 127ull}, // 2^28 - 1
+        {233ull, 1103ull, 2089ull}, // 2^29 - 1
+        {3ull, 7ull, 11ull, 31ull, 151ull, 331ull}, // 2^30 - 1
+        {2147483647ull}, // 2^31 - 1
+        {3ull, 5ull, 17ull, 257ull, 65537ull}, // 2^32 - 1
+        {7ull, 23ull, 89ull, 599479ull}, // 2^33 - 1
+        {3ull, 43691ull, 131071ull}, // 2^34 - 1
+        {31ull, 71ull, 127ull, 122921ull}, // 2^35 - 1
+        {3ull, 5ull, 7ull, 13ull, 19ull, 37ull, 73ull, 109ull}, // 2^36 - 1
+        {223ull, 616318177ull}, // 2^37 - 1
+        {3ull, 174763ull, 524287ull}, // 2^38 - 1
+        {7ull, 79ull, 8191ull, 121369ull}, // 2^39 - 1
+        {3ull, 5ull, 11ull, 17ull, 31ull, 41ull, 61681ull}, // 2^40 - 1
+        {13367ull, 164511353ull}, // 2^41 - 1
+        {3ull, 7ull, 43ull, 127ull, 337ull, 5419ull}, // 2^42 - 1
+        {431ull, 9719ull, 2099863ull}, // 2^43 - 1
+        {3ull, 5ull, 23ull, 89ull, 397ull, 683ull, 2113ull}, // 2^44 - 1
+        {7ull, 31ull, 73ull, 151ull, 631ull, 23311ull}, // 2^45 - 1
+        {3ull, 47ull, 178481ull, 2796203ull}, // 2^46 - 1
+        {2351ull, 4513ull, 13264529ull}, // 2^47 - 1
+        {3ull, 5ull, 7ull, 13ull, 17ull, 97ull, 241ull, 257ull, 673ull}, // 2^48 - 1
+        {127ull, 4432676798593ull}, // 2^49 - 1
+        {3ull, 11ull, 31ull, 251ull, 601ull, 1801ull, 4051ull}, // 2^50 - 1
+        {7ull, 103ull, 2143ull, 11119ull, 131071ull}, // 2^51 - 1
+        {3ull, 5ull, 53ull, 157ull, 1613ull, 2731ull, 8191ull}, // 2^52 - 1
+        {6361ull, 69431ull, 20394401ull}, // 2^53 - 1
+        {3ull, 7ull, 19ull, 73ull, 87211ull, 262657ull}, // 2^54 - 1
+        {23ull, 31ull, 89ull, 881ull, 3191ull, 201961ull}, // 2^55 - 1
+        {3ull, 5ull, 17ull, 29ull, 43ull, 113ull, 127ull, 15790321ull}, // 2^56 - 1
+        {7ull, 32377ull, 524287ull, 1212847ull}, // 2^57 - 1
+        {3ull, 59ull, 233ull, 1103ull, 2089ull, 3033169ull}, // 2^58 - 1
+        {179951ull, 3203431780337ull}, // 2^59 - 1
+        {3ull, 5ull, 7ull, 11ull, 13ull, 31ull, 41ull, 61ull, 151ull, 331ull, 1321ull}, // 2^60 - 1
+        {2305843009213693951ull}, // 2^61 - 1
+        {3ull, 715827883ull, 2147483647ull}, // 2^62 - 1
+        {7ull, 73ull, 127ull, 337ull, 92737ull, 649657ull}, // 2^63 - 1
     };
 
+    uint_fast64_t val;
+
+    [[nodiscard]] constexpr
+    uint_fast64_t derivative() const noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast64_t gcd(uint_fast64_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast8_t deg(uint_fast64_t) noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast64_t mod(uint_fast64_t, uint_fast64_t, uint_fast8_t) noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast8_t eliminate(uint_fast64_t *, uint_fast8_t) noexcept;
+
+    [[nodiscard]] constexpr
+    uint_fast64_t mulmod(uint_fast64_t, uint_fast64_t, uint_fast8_t) const noexcept;
+
+    [[nodiscard]] constexpr
+    uint_fast64_t powmod(uint_fast64_t, uint_fast64_t, uint_fast8_t) const noexcept;
+
+    [[nodiscard]] static
+    uint_fast64_t quotient(uint_fast64_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    uint_fast64_t period(uint_fast64_t, uint_fast8_t) noexcept;
+
+    [[nodiscard]] static
+    Factors squareFree(uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    Factors distinctDegree(uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    uint_fast8_t nullSpace(uint_fast8_t, uint_fast64_t *, uint_fast64_t *) noexcept;
+
+    [[nodiscard]]
+    uint_fast8_t berlekampMatrixRank(uint_fast8_t, uint_fast64_t *) const noexcept;
+
     [[nodiscard]]
-    static uint_fast64_t mod(uint_fast128_t, uint_fast128_t, uint_fast8_t) noexcept;
+    bool berlekamp(uint_fast8_t, uint_fast64_t *) const noexcept;
 
     [[nodiscard]]
-    uint_fast8_t berlekampMatrixRank(uint_fast8_t) const noexcept;
+    bool rabin(uint_fast8_t) const noexcept;
+
+    [[nodiscard]]
+    bool irreducible(uint_fast8_t, Method) const noexcept;
+
+    [[nodiscard]]
+    bool irreducible(uint_fast8_t, uint_fast64_t *, Method) const noexcept;
+
+    [[nodiscard]]
+    bool maximalOrder(uint_fast8_t) const noexcept;
 
 public:
-    explicit
+    explicit constexpr
     Polynomial(uint_fast64_t) noexcept;
 
+    [[nodiscard]] constexpr
+    bool IsIrredusible(uint_fast8_t, Method = Method::Auto) const noexcept;
+
+    [[nodiscard]] constexpr
+    bool IsIrredusible(uint_fast8_t, uint_fast64_t *, Method = Method::Auto) const noexcept;
+
+    [[nodiscard]] static constexpr
+    Method Choose(uint_fast8_t) noexcept;
+
     [[nodiscard]]
-    bool IsIrredusible(uint_fast8_t) const noexcept;
+    bool HasSmallFactor(uint_fast8_t, uint_fast8_t = 8) const noexcept;
+
+    [[nodiscard]] constexpr
+    bool HasMaximalOrder(uint_fast8_t) const noexcept;
+
+    [[nodiscard]] constexpr
+    bool IsPrimitive(uint_fast8_t, Method = Method::Auto) const noexcept;
 
     [[nodiscard]]
+    uint_fast64_t Order() const noexcept;
+
+    [[nodiscard]]
+    Factors Factor() const noexcept;
+
+    constexpr
+    void BerlekampMatrix(uint_fast8_t, uint_fast64_t *) const noexcept;
+
+    [[nodiscard]] constexpr
     uint_fast64_t Get() const noexcept;
+
+    [[nodiscard]] constexpr
+    uint_fast64_t Reverse(uint_fast8_t) const noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast64_t Count(uint_fast8_t) noexcept;
+
+    [[nodiscard]] static constexpr
+    uint_fast64_t First(uint_fast8_t, bool = false) noexcept;
+
+    template<uint_fast8_t Degree>
+    [[nodiscard]] static constexpr
+    auto All() noexcept;
+
+    [[nodiscard]] static
+    Stats::Table GetStats() noexcept;
 };
 
+/**
+ * Создаёт новый многочлен над полем GF[2^n], n = 0,...,63.
+ * @param[in] val представляет многочлен как 64-битное целое число,
+ * где представлению P(x) = a + b*x + c*x^2 соответствует число
+ * с побитовым представлением ...cba, здесь a, b, c = 0 или 1,
+ * т.к. коэффициенты многочлена лежат в поле GF[2].
+ */
+constexpr Polynomial<1>::Polynomial(const uint_fast64_t val) noexcept : val(val) {}
+
+/**
+ * @return текущий многочлен, представленный как 64-битное целое число.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::Get() const noexcept {
+    return val;
+}
+
+/**
+ * Зеркально отражает многочлен: P(x) -> x^n * P(1/x).
+ * Многочлен с ненулевым свободным членом неприводим тогда и только тогда,
+ * когда неприводим отражённый, поэтому проверять достаточно один из пары.
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @return отражённый многочлен.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::Reverse(const uint_fast8_t degree) const noexcept {
+    uint_fast64_t p = val;
+    p = ((p >> 1u) & 0x55'55'55'55'55'55'55'55ull) | ((p & 0x55'55'55'55'55'55'55'55ull) << 1u);
+    p = ((p >> 2u) & 0x33'33'33'33'33'33'33'33ull) | ((p & 0x33'33'33'33'33'33'33'33ull) << 2u);
+    p = ((p >> 4u) & 0x0F'0F'0F'0F'0F'0F'0F'0Full) | ((p & 0x0F'0F'0F'0F'0F'0F'0F'0Full) << 4u);
+    p = __builtin_bswap64(p);
+    return p >> (63u - degree);
+}
+
+/**
+ * Вычисляет производную многочлена над полем GF[2].
+ * @return многочлен, являющийся производной данного.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::derivative() const noexcept {
+    return (val & 0xAA'AA'AA'AA'AA'AA'AA'AAull) >> 1ull;
+}
+
+/**
+ * Определяет, являются ли два многочлена взаимно простыми.
+ * @param[in] p1 первый многочлен, старшей степени.
+ * @param[in] p2 второй многочлен, младшей степени.
+ * @return не взаимно просты ли два проверяемых многочлена,
+ * ведущее отрицание используется для уменьшения числа выполняемых операций.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::gcd(
+        uint_fast64_t p1, uint_fast64_t p2
+) noexcept {
+    uint_fast64_t temp = 0;
+    while (p2 != 0) {
+        temp = mod(p1, p2, deg(p2));
+        p1 = p2;
+        p2 = temp;
+    }
+    return p1;
+}
+
+/**
+ * Вычисляет степень многочлена, представленного как 64-битное число.
+ * Для вычисления степени используется встроенная в процессоры архитектуры
+ * AMD64 и ARM команда для подсчёта числа ведущих нулей в числе.
+ * Поэтому данный код можно компилировать только с использованием GCC (Clang).
+ * Степень многочлена находится вычитанием из 63 (максимальная возможная степень)
+ * числа ведущих нулей. Например, если число ведущих нулей 0, значит
+ * старший бит – единица, значит многочлен степени 63 = 63 - 0.
+ * @param[in] p многочлен, степень от 0 до 63.
+ * @return степень многочлена от 0 до 63.
+ */
+[[nodiscard]] constexpr
+uint_fast8_t Polynomial<1>::deg(const uint_fast64_t p) noexcept {
+    if (p == 0) { return 0; }
+    return static_cast<uint_fast8_t>
+    (63ull - __builtin_clzll(static_cast<unsigned long long>(p)));
+}
+
+/**
+ * @param p1 делимое.
+ * @param p2 делитель.
+ * @param degree степень делителя.
+ * @return многочлен p1 по модулю многочлена p2.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::mod(
+        uint_fast64_t p1, const uint_fast64_t p2, const uint_fast8_t degree
+) noexcept {
+    for (uint_fast8_t i = deg(p1); i >= degree && p1 != 0; i = deg(p1)) {
+        p1 ^= (p2 << static_cast<uint_fast8_t>(i - degree));
+    }
+    return p1;
+}
+
+/**
+ * Вычисляет ранг матрицы над полем GF[2] методом Гаусса без SIMD-инструкций
+ * (см. Rank::Get), используется при вычислениях во время компиляции.
+ * @param[in,out] M матрица, строки которой хранятся в виде 64-битных чисел,
+ * содержимое после вычисления не сохраняется.
+ * @param[in] degree число строк и столбцов матрицы, от 1 до 63.
+ * @return ранг матрицы.
+ */
+[[nodiscard]] constexpr
+uint_fast8_t Polynomial<1>::eliminate(uint_fast64_t *const M, const uint_fast8_t degree) noexcept {
+    uint_fast8_t rank = 0;
+    for (uint_fast8_t k = 0; k < degree; ++k) {
+        const uint_fast64_t b = 1ull << k;
+        uint_fast8_t r = rank;
+        while (r < degree && !(M[r] & b)) { ++r; }
+        if (r == degree) { continue; }
+        const uint_fast64_t pivot = M[r];
+        M[r] = M[rank];
+        M[rank] = pivot;
+        for (uint_fast8_t j = rank + 1; j < degree; ++j) {
+            if (M[j] & b) { M[j] ^= pivot; }
+        }
+        ++rank;
+    }
+    return rank;
+}
+
+/**
+ * Умножает многочлены по модулю текущего многочлена по одному биту
+ * множителя за шаг, используется при вычислениях во время компиляции
+ * (во время работы программы умножение выполняет Clmul).
+ * @param[in] a первый множитель, многочлен степени меньше degree.
+ * @param[in] b второй множитель.
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @return a * b по модулю текущего многочлена.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::mulmod(
+        const uint_fast64_t a, const uint_fast64_t b, const uint_fast8_t degree
+) const noexcept {
+    uint_fast64_t r = 0;
+    for (uint_fast8_t i = deg(b) + 1; i-- > 0;) {
+        r <<= 1ull;
+        if ((r >> degree) & 1ull) { r ^= val; }
+        if ((b >> i) & 1ull) { r ^= a; }
+    }
+    return r;
+}
+
+/**
+ * Возводит многочлен в степень по модулю текущего многочлена,
+ * двигаясь от старших бит показателя (см. mulmod).
+ * @param[in] a основание, многочлен степени меньше degree.
+ * @param[in] e показатель степени.
+ * @param[in] degree степень текущего многочлена, от 1 до 63.
+ * @return a^e по модулю текущего многочлена.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::powmod(
+        const uint_fast64_t a, const uint_fast64_t e, const uint_fast8_t degree
+) const noexcept {
+    uint_fast64_t r = 1;
+    for (uint_fast8_t i = deg(e) + 1; i-- > 0;) {
+        r = mulmod(r, r, degree);
+        if ((e >> i) & 1ull) { r = mulmod(r, a, degree); }
+    }
+    return r;
+}
+
+/**
+ * Выполняет построение матрицы Берлекампа.
+ * Строится матрица M[nxn], где строки - коэффициенты многочлена x^(ip) (mod P(x)),
+ * где p - двойка, 0 < i < n, P(x) - текущий многочлен над полем GF[2] степени n.
+ * Строки вычисляются последовательно: x^(2(i+1)) = x^(2i) * x^2 (mod P(x)),
+ * поэтому на построение каждой строки уходит два сдвига.
+ * Подробное описание и пример расчёта можно найти в статье
+ * "A Formalization of Berlekamp’s Factorization Algorithm" по ссылке
+ * http://www21.in.tum.de/~nipkow/Isabelle2016/Isabelle2016_6.pdf (стр. 3-4).
+ * Матрица строится в зеркально отражённом виде для оптимизации хранимых данных.
+ * Затем из матрицы вычитается единичная матрица.
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[out] M буфер под матрицу размером не менее degree элементов.
+ */
+constexpr
+void Polynomial<1>::BerlekampMatrix(
+        const uint_fast8_t degree, uint_fast64_t *const M
+) const noexcept {
+    uint_fast64_t temp = 1;
+
+    // x ^ ip, p = 2: каждая строка получается из предыдущей умножением на x^2,
+    // умножение на x - сдвиг, после которого старший коэффициент
+    // x^degree заменяется на P(x) - x^degree
+    for (uint_fast8_t i = 0; i < degree; ++i) {
+        M[i] = temp ^ (1ull << i); // M -= E (mod 2)
+        temp = (temp << 1ull) ^ ((temp >> (degree - 1u)) & 1ull ? val : 0);
+        temp = (temp << 1ull) ^ ((temp >> (degree - 1u)) & 1ull ? val : 0);
+    }
+}
+
+/**
+ * Выбирает алгоритм проверки неприводимости для многочленов заданной степени.
+ * Граница получена замером среднего времени проверки случайных многочленов
+ * с единичными младшим и старшим коэффициентами: сейчас алгоритм Рабина
+ * быстрее во всём диапазоне степеней (в 2.5 раза на степени 8
+ * и в 5 раз на степени 63), т.к. большинство кандидатов отбрасывается
+ * на первых шагах Бен-Ора, не дойдя до построения матрицы.
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @return алгоритм, который в среднем быстрее на многочленах данной степени.
+ */
+[[nodiscard]] constexpr
+Polynomial<1>::Method Polynomial<1>::Choose(const uint_fast8_t degree) noexcept {
+    // степени, начиная с которой алгоритм Рабина быстрее алгоритма Берлекампа
+    constexpr uint_fast8_t crossover = 2;
+    return degree < crossover ? Method::Berlekamp : Method::Rabin;
+}
+
+/**
+ * Определяет, является ли данный многочлен степени n неприводимым в поле GF[2].
+ * Для определения неприводимости используется алгоритм Берлекампа
+ * или алгоритм Рабина с ранним выходом по Бен-Ору (см. rabin).
+ * Проверка алгоритмом Берлекампа состоит из трёх шагов.
+ * Первый шаг - вычисление производной данного многочлена. Если производная
+ * равна нулю, то многочлен является степенью какого-то другого многочлена,
+ * то есть он приводим.
+ * Второй шаг - поиск общих множителей многочлена и его производной.
+ * Если общие множители (многочлены, а не числа) есть, т.е. многочлены
+ * не взаимно просты, то f(x) делится на них, т.е. он не неприводим.
+ * Третий шаг - простоение матрицы Берлекампа и вычисление её ранга.
+ * Если ранг матрицы Берлекампа равен степени многочлена минус 1,
+ * то многочлен неприводим.
+ * Проверку можно выполнять во время компиляции, например в static_assert.
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[in] method алгоритм проверки, по умолчанию выбирается по степени.
+ * @return является ли данный многочлен степени n неприводимы над полем GF[2].
+ */
+[[nodiscard]] constexpr
+bool Polynomial<1>::IsIrredusible(const uint_fast8_t degree, const Method method) const noexcept {
+    if (!__builtin_is_constant_evaluated()) { return irreducible(degree, method); }
+    uint_fast64_t M[64] = {};
+    return IsIrredusible(degree, M, method);
+}
+
+/**
+ * То же, что и IsIrredusible(degree), но матрица Берлекампа строится
+ * в переданном буфере. Позволяет не выделять память под матрицу
+ * при каждой проверке, если проверок выполняется много подряд.
+ * Во время компиляции всегда используется алгоритм Берлекампа
+ * с предварительным поиском делителей малой степени,
+ * ранг вычисляется без SIMD-инструкций (см. eliminate).
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[out] buffer буфер размером не менее degree элементов.
+ * @param[in] method алгоритм проверки, по умолчанию выбирается по степени.
+ * @return является ли данный многочлен степени n неприводимы над полем GF[2].
+ */
+[[nodiscard]] constexpr
+bool Polynomial<1>::IsIrredusible(
+        const uint_fast8_t degree, uint_fast64_t *const buffer, const Method method
+) const noexcept {
+    if (!__builtin_is_constant_evaluated()) { return irreducible(degree, buffer, method); }
+    // многочлены степени не выше 5 делят x^(2^k) - x при k = 3, 4, 5,
+    // проверка наличия таких делителей дешевле построения матрицы
+    if (degree > 5) {
+        for (uint_fast8_t k = 3; k <= 5; ++k) {
+            if (gcd(val, (1ull << (1u << k)) | 2ull) != 1) { return false; }
+        }
+    }
+    const uint_fast64_t pp = derivative();
+    if (pp == 0 || gcd(val, pp) != 1) { return false; }
+    BerlekampMatrix(degree, buffer);
+    return eliminate(buffer, degree) == degree - 1;
+}
+
+/**
+ * Определяет, равен ли порядок неприводимого многочлена степени n
+ * максимально возможному 2^n - 1: для этого x^((2^n-1)/q) != 1
+ * по модулю многочлена для всех простых q, делящих 2^n - 1 (см. mersenne).
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @return имеет ли многочлен порядок 2^n - 1, если он неприводим.
+ */
+[[nodiscard]] constexpr
+bool Polynomial<1>::HasMaximalOrder(const uint_fast8_t degree) const noexcept {
+    if (!__builtin_is_constant_evaluated()) { return maximalOrder(degree); }
+    const uint_fast64_t x = mod(2, val, degree);
+    const uint_fast64_t e = (1ull << degree) - 1;
+    for (const uint_fast64_t q : mersenne[degree]) {
+        if (q == 0) { break; }
+        if (powmod(x, e / q, degree) == 1) { return false; }
+    }
+    return true;
+}
+
+/**
+ * Определяет, является ли многочлен примитивным, т.е. неприводимым
+ * многочленом степени n с порядком 2^n - 1. Такие многочлены задают
+ * регистры сдвига с линейной обратной связью максимального периода.
+ * @param[in] degree степень текущего многочлена, от 1 до 63,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @param[in] method алгоритм проверки неприводимости (см. IsIrredusible).
+ * @return является ли данный многочлен примитивным.
+ */
+[[nodiscard]] constexpr
+bool Polynomial<1>::IsPrimitive(const uint_fast8_t degree, const Method method) const noexcept {
+    return (val & 1ull) && IsIrredusible(degree, method) && HasMaximalOrder(degree);
+}
+
+/**
+ * Вычисляет число неприводимых многочленов заданной степени
+ * по формуле Гаусса N(n) = 1/n * sum(mu(n/k) * 2^k), k | n.
+ * Вычисления ведутся по модулю 2^64, что не влияет на итоговый результат,
+ * т.к. он заведомо меньше 2^63.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @return число неприводимых многочленов степени degree.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::Count(const uint_fast8_t degree) noexcept {
+    uint_fast64_t sum = 0;
+    for (uint_fast8_t k = 1; k <= degree; ++k) {
+        if (degree % k) { continue; }
+        // функция Мёбиуса от degree / k
+        int_fast8_t mu = 1;
+        for (uint_fast8_t m = degree / k, q = 2; m > 1; ++q) {
+            if (m % q) { continue; }
+            m /= q;
+            if (m % q == 0) { mu = 0; break; }
+            mu = -mu;
+        }
+        if (mu > 0) { sum += 1ull << k; }
+        if (mu < 0) { sum -= 1ull << k; }
+    }
+    return sum / degree;
+}
+
+/**
+ * Находит наименьший (как целое число) неприводимый или примитивный
+ * многочлен заданной степени. Предназначен для построения таблиц
+ * во время компиляции, во время работы программы поиск выполняется
+ * теми же быстрыми алгоритмами, что и IsIrredusible.
+ * @param[in] degree степень многочлена, от 1 до 63.
+ * @param[in] primitive искать ли примитивный многочлен (см. IsPrimitive).
+ * @return наименьший подходящий многочлен степени degree.
+ */
+[[nodiscard]] constexpr
+uint_fast64_t Polynomial<1>::First(const uint_fast8_t degree, const bool primitive) noexcept {
+    // при степени больше 1 многочлен, делящийся на x, приводим
+    const uint_fast64_t step = degree > 1 ? 2 : 1;
+    for (uint_fast64_t p = (1ull << degree) | (step - 1); p != 0; p += step) {
+        const Polynomial candidate(p);
+        if (primitive ? candidate.IsPrimitive(degree) : candidate.IsIrredusible(degree)) { return p; }
+    }
+    return 0;
+}
+
+/**
+ * Перечисляет все неприводимые многочлены заданной степени в порядке
+ * возрастания. При вычислении во время компиляции для степеней больше 17
+ * потребуется увеличить ограничение компилятора на число итераций цикла
+ * (-fconstexpr-loop-limit для GCC).
+ * @tparam Degree степень многочленов, от 1 до 63.
+ * @return массив из Count(Degree) неприводимых многочленов.
+ */
+template<uint_fast8_t Degree>
+[[nodiscard]] constexpr
+auto Polynomial<1>::All() noexcept {
+    static_assert(Degree >= 1 && Degree <= 63, "degree must be from 1 to 63");
+    std::array<uint_fast64_t, Count(Degree)> res{};
+    std::size_t i = 0;
+    for (uint_fast64_t p = 1ull << Degree; i < res.size(); ++p) {
+        if (Polynomial(p).IsIrredusible(Degree)) { res[i++] = p; }
+    }
+    return res;
+}
+
+/**
+ * Создаёт новый многочлен над полем GF[2] степени не выше 64 * Words - 1,
+ * коэффициенты которого умещаются в одно 64-битное слово.
+ * @param[in] low младшие 64 коэффициента многочлена, остальные нулевые.
+ */
+template<std::size_t Words>
+Polynomial<Words>::Polynomial(const uint_fast64_t low) noexcept : val() {
+    val[0] = low;
+}
+
+/**
+ * Создаёт новый многочлен над полем GF[2] степени не выше 64 * Words - 1.
+ * @param[in] val коэффициенты многочлена, слово val[i] хранит
+ * коэффициенты при x^(64*i), ..., x^(64*i+63) так же, как и в Polynomial<1>.
+ */
+template<std::size_t Words>
+Polynomial<Words>::Polynomial(const Bits &val) noexcept : val(val) {}
+
+/**
+ * @return текущий многочлен, представленный массивом 64-битных слов.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+typename Polynomial<Words>::Bits Polynomial<Words>::Get() const noexcept {
+    return val;
+}
+
+/**
+ * Вычисляет производную многочлена над полем GF[2].
+ * @return многочлен, являющийся производной данного.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+typename Polynomial<Words>::Bits Polynomial<Words>::derivative() const noexcept {
+    Bits res;
+    for (std::size_t i = 0; i < Words; ++i) {
+        res[i] = val[i] & 0xAA'AA'AA'AA'AA'AA'AA'AAull;
+    }
+    shiftRight(res);
+    return res;
+}
+
+/**
+ * Определяет степень многочлена над полем GF[2].
+ * @param[in] p многочлен, степень которого требуется найти.
+ * @return степень многочлена, -1 для нулевого многочлена.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+int_fast16_t Polynomial<Words>::deg(const Bits &p) noexcept {
+    for (std::size_t i = Words; i-- > 0;) {
+        if (p[i]) { return int_fast16_t(64 * i + 63 - __builtin_clzll(p[i])); }
+    }
+    return -1;
+}
+
+/**
+ * Сравнивает многочлены как целые числа, что для многочленов
+ * с разными степенями равносильно сравнению степеней.
+ * @return меньше ли первый многочлен второго.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Polynomial<Words>::less(const Bits &p1, const Bits &p2) noexcept {
+    for (std::size_t i = Words; i-- > 0;) {
+        if (p1[i] != p2[i]) { return p1[i] < p2[i]; }
+    }
+    return false;
+}
+
+/**
+ * Умножает многочлен на x, старший коэффициент теряется.
+ * @param[in,out] p изменяемый многочлен.
+ */
+template<std::size_t Words>
+void Polynomial<Words>::shiftLeft(Bits &p) noexcept {
+    for (std::size_t i = Words - 1; i > 0; --i) {
+        p[i] = (p[i] << 1u) | (p[i - 1] >> 63u);
+    }
+    p[0] <<= 1u;
+}
+
+/**
+ * Делит многочлен на x, младший коэффициент теряется.
+ * @param[in,out] p изменяемый многочлен.
+ */
+template<std::size_t Words>
+void Polynomial<Words>::shiftRight(Bits &p) noexcept {
+    for (std::size_t i = 0; i < Words - 1; ++i) {
+        p[i] = (p[i] >> 1u) | (p[i + 1] << 63u);
+    }
+    p[Words - 1] >>= 1u;
+}
+
+/**
+ * Определяет, являются ли два многочлена взаимно простыми.
+ * Вместо деления с остатком, которое для многословных многочленов требует
+ * сдвига делителя на каждом шаге, используется бинарный алгоритм:
+ * чётный (делящийся на x) многочлен делится на x, из большего
+ * нечётного вычитается меньший. Каждый шаг стоит O(Words) операций,
+ * а число шагов не превышает удвоенной суммы степеней.
+ * @param[in] p1 первый многочлен, младший коэффициент обязан быть единицей.
+ * @param[in] p2 второй многочлен.
+ * @return взаимно просты ли два проверяемых многочлена.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Polynomial<Words>::coprime(Bits p1, Bits p2) noexcept {
+    while (deg(p2) >= 0) {
+        if (!(p2[0] & 1u)) {
+            shiftRight(p2);
+            continue;
+        }
+        if (less(p2, p1)) { std::swap(p1, p2); }
+        for (std::size_t i = 0; i < Words; ++i) { p2[i] ^= p1[i]; }
+    }
+    return deg(p1) == 0;
+}
+
+/**
+ * Строит матрицу Берлекампа и вычисляет ранг матрицы Q - E.
+ * Матрица хранится на стеке (64 * Words строк по Words слов), её строки
+ * строятся последовательным умножением на x^2 по модулю многочлена,
+ * как и в Polynomial<1>::BerlekampMatrix. При исключении Гаусса
+ * столбцы обрабатываются от младшего к старшему, поэтому у строк
+ * ниже ведущей младшие слова уже нулевые и не обрабатываются.
+ * Условие остановки опрашивается через каждые 64 строки и столбца.
+ * @param[in] degree степень многочлена.
+ * @param[in] stop условие досрочной остановки.
+ * @return ранг матрицы Q - E или 0, если вычисление было прервано.
+ */
+template<std::size_t Words>
+template<typename Stop>
+[[nodiscard]]
+uint_fast16_t Polynomial<Words>::berlekampMatrixRank(const uint_fast16_t degree, const Stop &stop) const noexcept {
+    std::array<Bits, 64 * Words> M;
+    Bits t{};
+    t[0] = 1u;
+    for (uint_fast16_t i = 0; i < degree; ++i) {
+        if ((i & 63u) == 0 && stop()) { return 0; }
+        M[i] = t;
+        M[i][i >> 6u] ^= 1ull << (i & 63u);
+        for (uint_fast8_t k = 0; k < 2; ++k) {
+            shiftLeft(t);
+            if ((t[degree >> 6u] >> (degree & 63u)) & 1u) {
+                for (std::size_t j = 0; j < Words; ++j) { t[j] ^= val[j]; }
+            }
+        }
+    }
+
+    uint_fast16_t rank = 0, r, j;
+    std::size_t w, x;
+    uint_fast64_t b;
+    for (uint_fast16_t k = 0; k < degree; ++k) {
+        if ((k & 63u) == 0 && stop()) { return 0; }
+        w = k >> 6u;
+        b = 1ull << (k & 63u);
+        for (r = rank; r < degree && !(M[r][w] & b); ++r);
+        if (r == degree) { continue; }
+        std::swap(M[r], M[rank]);
+        for (j = rank + 1; j < degree; ++j) {
+            if (!(M[j][w] & b)) { continue; }
+            for (x = w; x < Words; ++x) { M[j][x] ^= M[rank][x]; }
+        }
+        ++rank;
+    }
+    return rank;
+}
+
+/**
+ * Определяет, является ли многочлен неприводимым над полем GF[2],
+ * тем же методом Берлекампа, что и Polynomial<1>::IsIrredusible.
+ * Матрица размещается на стеке: 512 КиБ для Words = 32 (степень до 2047).
+ * @param[in] degree степень многочлена, от 2 до 64 * Words - 1,
+ * не проверяется корректность для уменьшания числа выполняемых операций.
+ * @return является ли многочлен неприводимым.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Polynomial<Words>::IsIrredusible(const uint_fast16_t degree) const noexcept {
+    return IsIrredusible(degree, [] { return false; });
+}
+
+/**
+ * Определяет, является ли многочлен неприводимым над полем GF[2],
+ * с возможностью прервать проверку: при степени 2047 построение и
+ * исключение матрицы занимают сотни миллисекунд, и поиск, уже нашедший
+ * многочлен в другом потоке, не должен дожидаться завершения остальных.
+ * @param[in] degree степень многочлена, от 2 до 64 * Words - 1.
+ * @param[in] stop функция без аргументов, возвращающая true,
+ * если проверку следует прекратить; вызывается из того же потока.
+ * @return является ли многочлен неприводимым; false, если проверка прервана.
+ */
+template<std::size_t Words>
+template<typename Stop>
+[[nodiscard]]
+bool Polynomial<Words>::IsIrredusible(const uint_fast16_t degree, const Stop &stop) const noexcept {
+    // многочлен, делящийся на x, приводим
+    if (!(val[0] & 1u)) { return false; }
+    const Bits d = derivative();
+    if (deg(d) < 0 || !coprime(val, d)) { return false; }
+    return berlekampMatrixRank(degree, stop) == degree - 1;
+}
+
 #endif //BERLEKAMP_POLYNOMIAL_HPP
@@ -1,18 +0,0 @@
-/**
- * @file    Random.hpp
- * @author  Vadim Piven <vadim@piven.tech>
- * @date    2019/10/01
- * @license Free use of this library is permitted under the
- * guidelines and in accordance with the MIT License (MIT).
- * @url     https://github.com/vadimpiven/irrpolygf2
- */
-
-#ifndef BERLEKAMP_RANDOM_HPP
-#define BERLEKAMP_RANDOM_HPP
-
-#include <cstdint>
-
-[[nodiscard]]
-uint_fast64_t Random(uint_fast8_t) noexcept;
-
-#endif //BERLEKAMP_RANDOM_HPP
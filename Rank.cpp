@@ -0,0 +1,229 @@
+/**
+ * @file    Rank.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <atomic>
+
+#include "Rank.hpp"
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define RANK_X86
+#endif
+
+#ifdef RANK_X86
+
+/**
+ * Вычисляет ранг матрицы над полем GF[2] размером до 64x64, целиком
+ * размещённой в восьми регистрах AVX-512 (по 8 строк в регистре).
+ * Для каждого столбца k одновременно для всех строк вычисляется маска строк,
+ * в которых стоит единица в столбце k. Опорной выбирается первая из них,
+ * ещё не бывшая опорной (если таких нет, маска опорной строки пуста).
+ * Опорная строка рассылается во все дорожки и прибавляется маскированным
+ * XOR ко всем остальным строкам с единицей в столбце k.
+ * Выполняемые команды не зависят от данных, ветвлений нет.
+ * @param[in] M матрица, строки которой записаны в младших битах чисел.
+ * @param[in] degree размер матрицы, от 1 до 63.
+ * @return ранг матрицы.
+ */
+[[nodiscard]] static __attribute__((target("avx512f")))
+uint_fast8_t rank512(const uint_fast64_t *const M, const uint_fast8_t degree) noexcept {
+    alignas(64) uint64_t rows[64] = {};
+    for (uint_fast8_t i = 0; i < degree; ++i) { rows[i] = M[i]; }
+    __m512i r[8];
+#pragma GCC unroll 8
+    for (uint_fast8_t v = 0; v < 8; ++v) { r[v] = _mm512_load_si512(rows + 8 * v); }
+
+    uint64_t used = 0, has, pivot;
+    uint_fast8_t rank = 0;
+    for (uint_fast8_t k = 0; k < degree; ++k) {
+        const __m512i bit = _mm512_set1_epi64(static_cast<long long>(1ull << k));
+        has = 0;
+#pragma GCC unroll 8
+        for (uint_fast8_t v = 0; v < 8; ++v) {
+            has |= static_cast<uint64_t>(_mm512_test_epi64_mask(r[v], bit)) << (8u * v);
+        }
+        pivot = has & ~used;
+        pivot &= -pivot; // младший бит, 0 если опорной строки нет
+        used |= pivot;
+        rank += pivot != 0;
+
+        // рассылка опорной строки во все дорожки
+        __m512i p = _mm512_setzero_si512();
+#pragma GCC unroll 8
+        for (uint_fast8_t v = 0; v < 8; ++v) {
+            p = _mm512_mask_or_epi64(p, static_cast<__mmask8>(pivot >> (8u * v)), p, r[v]);
+        }
+        // свёртка вручную: _mm512_reduce_or_epi64 и немаскированное
+        // извлечение половин в GCC 12 дают -Wuninitialized
+        const __m256i h = _mm256_or_si256(_mm512_maskz_extracti64x4_epi64(0xFF, p, 0),
+                                          _mm512_maskz_extracti64x4_epi64(0xFF, p, 1));
+        __m128i q = _mm_or_si128(_mm256_castsi256_si128(h), _mm256_extracti128_si256(h, 1));
+        q = _mm_or_si128(q, _mm_unpackhi_epi64(q, q));
+        p = _mm512_set1_epi64(_mm_cvtsi128_si64(q));
+
+        has &= ~pivot;
+#pragma GCC unroll 8
+        for (uint_fast8_t v = 0; v < 8; ++v) {
+            r[v] = _mm512_mask_xor_epi64(r[v], static_cast<__mmask8>(has >> (8u * v)), r[v], p);
+        }
+    }
+    return rank;
+}
+
+/**
+ * То же, что и rank512, но матрица размещается в шестнадцати регистрах AVX2
+ * (по 4 строки в регистре). Маски строк получаются сравнением и movemask,
+ * а вместо маскированного XOR используется XOR с маской-вектором.
+ * @param[in] M матрица, строки которой записаны в младших битах чисел.
+ * @param[in] degree размер матрицы, от 1 до 63.
+ * @return ранг матрицы.
+ */
+[[nodiscard]] static __attribute__((target("avx2")))
+uint_fast8_t rank256(const uint_fast64_t *const M, const uint_fast8_t degree) noexcept {
+    alignas(32) uint64_t rows[64] = {};
+    for (uint_fast8_t i = 0; i < degree; ++i) { rows[i] = M[i]; }
+    __m256i r[16], index[16];
+#pragma GCC unroll 16
+    for (uint_fast8_t v = 0; v < 16; ++v) {
+        r[v] = _mm256_load_si256(reinterpret_cast<const __m256i *>(rows + 4 * v));
+        index[v] = _mm256_set_epi64x(4 * v + 3, 4 * v + 2, 4 * v + 1, 4 * v);
+    }
+
+    uint64_t used = 0, has, pivot;
+    uint_fast8_t rank = 0;
+    for (uint_fast8_t k = 0; k < degree; ++k) {
+        const __m256i bit = _mm256_set1_epi64x(static_cast<long long>(1ull << k));
+        has = 0;
+#pragma GCC unroll 16
+        for (uint_fast8_t v = 0; v < 16; ++v) {
+            const __m256i m = _mm256_cmpeq_epi64(_mm256_and_si256(r[v], bit), bit);
+            has |= static_cast<uint64_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m))) << (4u * v);
+        }
+        pivot = has & ~used;
+        pivot &= -pivot; // младший бит, 0 если опорной строки нет
+        used |= pivot;
+        rank += pivot != 0;
+
+        // рассылка опорной строки во все дорожки
+        const __m256i at = _mm256_set1_epi64x(pivot ? __builtin_ctzll(pivot) : 64);
+        __m256i p = _mm256_setzero_si256();
+#pragma GCC unroll 16
+        for (uint_fast8_t v = 0; v < 16; ++v) {
+            p = _mm256_or_si256(p, _mm256_and_si256(r[v], _mm256_cmpeq_epi64(index[v], at)));
+        }
+        p = _mm256_or_si256(p, _mm256_permute4x64_epi64(p, 0x4E));
+        p = _mm256_or_si256(p, _mm256_permute4x64_epi64(p, 0xB1));
+
+#pragma GCC unroll 16
+        for (uint_fast8_t v = 0; v < 16; ++v) {
+            const __m256i m = _mm256_andnot_si256(
+                    _mm256_cmpeq_epi64(index[v], at),
+                    _mm256_cmpeq_epi64(_mm256_and_si256(r[v], bit), bit));
+            r[v] = _mm256_xor_si256(r[v], _mm256_and_si256(p, m));
+        }
+    }
+    return rank;
+}
+
+#endif
+
+/**
+ * Наибольшая разрядность векторных команд для вычисления ранга (см. Rank::Limit).
+ */
+static std::atomic<uint_fast16_t> limit(512);
+
+/**
+ * Определяет один раз за время работы программы, какие векторные команды,
+ * необходимые для вычисления ранга в регистрах, поддерживает процессор.
+ * @return 512 для AVX-512, 256 для AVX2, 0 если ранг вычисляется без них
+ * (в том числе если они запрещены вызовом Limit).
+ */
+[[nodiscard]]
+uint_fast16_t Rank::Hardware() noexcept {
+#ifdef RANK_X86
+    static const uint_fast16_t res = __builtin_cpu_supports("avx512f") ? 512 :
+                                     __builtin_cpu_supports("avx2") ? 256 : 0;
+    const uint_fast16_t l = limit.load(std::memory_order_relaxed);
+    return res <= l ? res : l >= 256 ? 256 : 0;
+#else
+    return 0;
+#endif
+}
+
+/**
+ * Ограничивает разрядность векторных команд, которыми вычисляется ранг,
+ * например чтобы сравнить на одном процессоре результаты всех вариантов.
+ * Действует на все последующие вызовы Get во всех потоках.
+ * @param[in] bits 512 - без ограничений, 256 - не больше AVX2, 0 - без векторных команд.
+ */
+void Rank::Limit(const uint_fast16_t bits) noexcept {
+    limit.store(bits, std::memory_order_relaxed);
+}
+
+/**
+ * Вычисляет ранг матрицы над полем GF[2] приведением к ступенчатому виду.
+ * @param[in,out] M матрица, строки которой записаны в младших битах чисел,
+ * после вычисления содержит ступенчатый вид матрицы.
+ * @param[in] degree размер матрицы, от 1 до 63.
+ * @return ранг матрицы.
+ */
+[[nodiscard]]
+uint_fast8_t Rank::Portable(uint_fast64_t *const M, const uint_fast8_t degree) noexcept {
+    uint_fast64_t temp;
+    uint_fast8_t i, j, k;
+    bool flag;
+
+    for (i = k = 0, temp = 1; i < degree && k < degree; ++k, temp <<= 1ull) {
+        flag = M[i] & temp;
+        for (j = i + 1; j < degree; ++j) {
+            if (M[j] & temp) {
+                switch (flag) { // ~if-else
+                case false: // swap
+                    M[i] ^= M[j];
+                    M[j] = M[i] ^ M[j];
+                    M[i] ^= M[j];
+                    flag = true;
+                    continue;
+                default: // Mj -= Mi
+                    M[j] ^= M[i];
+                }
+            }
+        }
+        i += flag;
+    }
+    return i;
+}
+
+/**
+ * Вычисляет ранг матрицы над полем GF[2] в регистрах AVX-512 или AVX2,
+ * если процессор их поддерживает, иначе приведением к ступенчатому виду.
+ * Матрицы размером меньше 10 всегда обрабатываются приведением
+ * к ступенчатому виду, т.к. по замерам оно для них быстрее.
+ * @param[in,out] M матрица, строки которой записаны в младших битах чисел,
+ * после вычисления её содержимое не определено.
+ * @param[in] degree размер матрицы, от 1 до 63.
+ * @return ранг матрицы.
+ */
+[[nodiscard]]
+uint_fast8_t Rank::Get(uint_fast64_t *const M, const uint_fast8_t degree) noexcept {
+    // для маленьких матриц загрузка в регистры дороже самого вычисления
+    static const uint_fast8_t crossover = 10;
+
+#ifdef RANK_X86
+    switch (degree < crossover ? 0 : Hardware()) {
+    case 512:
+        return rank512(M, degree);
+    case 256:
+        return rank256(M, degree);
+    default:
+        break;
+    }
+#endif
+    return Portable(M, degree);
+}
@@ -0,0 +1,30 @@
+/**
+ * @file    Rank.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_RANK_HPP
+#define BERLEKAMP_RANK_HPP
+
+#include <cstdint>
+
+class Rank {
+public:
+    [[nodiscard]] static
+    uint_fast8_t Get(uint_fast64_t *, uint_fast8_t) noexcept;
+
+    [[nodiscard]] static
+    uint_fast8_t Portable(uint_fast64_t *, uint_fast8_t) noexcept;
+
+    [[nodiscard]] static
+    uint_fast16_t Hardware() noexcept;
+
+    static
+    void Limit(uint_fast16_t) noexcept;
+};
+
+#endif //BERLEKAMP_RANK_HPP
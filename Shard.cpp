@@ -0,0 +1,304 @@
+/**
+ * @file    Shard.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <cerrno>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include "Enumerator.hpp"
+#include "Polynomial.hpp"
+#include "Shard.hpp"
+
+/**
+ * Число кандидатов, проверяемых между проверками времени контрольной точки:
+ * около 0.1 секунды работы одного потока для степеней около 40.
+ */
+static const uint_fast64_t slice = 1ull << 22u;
+
+/**
+ * Записывает буфер целиком, повторяя прерванные и неполные записи.
+ * @param[in] fd файл.
+ * @param[in] data буфер.
+ * @param[in] size размер буфера в байтах.
+ * @return записан ли буфер.
+ */
+[[nodiscard]] static
+bool put(const int fd, const void *const data, const std::size_t size) noexcept {
+    bool ok = true;
+    for (std::size_t done = 0; ok && done < size;) {
+        const ssize_t n = ::write(fd, static_cast<const char *>(data) + done, size - done);
+        if (n > 0) { done += n; }
+        ok = n > 0 || (n < 0 && errno == EINTR);
+    }
+    return ok;
+}
+
+/**
+ * @param[in] prefix общее начало имён файлов перебора.
+ * @param[in] degree степень многочленов.
+ * @param[in] index номер части.
+ * @param[in] shards число частей.
+ * @return имя файлов части без расширения, например prefix.40.3-of-16.
+ */
+[[nodiscard]]
+std::string Shard::name(
+        const char *const prefix, const uint_fast8_t degree,
+        const uint_fast64_t index, const uint_fast64_t shards
+) noexcept {
+    return std::string(prefix) + '.' + std::to_string(degree) + '.' +
+           std::to_string(index) + "-of-" + std::to_string(shards);
+}
+
+/**
+ * Сохраняет контрольную точку атомарно: текст записывается во временный
+ * файл, сбрасывается на диск и переименовывается поверх прежнего,
+ * поэтому после сбоя на диске остаётся либо старая, либо новая точка.
+ * @param[in] path имя файла контрольной точки.
+ * @param[in] c состояние части перебора.
+ * @return сохранена ли контрольная точка.
+ */
+[[nodiscard]]
+bool Shard::save(const std::string &path, const Checkpoint &c) noexcept {
+    char text[512];
+    const int size = std::snprintf(
+            text, sizeof(text),
+            "degree %u\nshard %" PRIuFAST64 " %" PRIuFAST64 "\nfirst %" PRIuFAST64 "\nlast %" PRIuFAST64
+            "\nnext %" PRIuFAST64 "\ncount %" PRIuFAST64 "\nbytes %" PRIuFAST64 "\n",
+            unsigned(c.degree), c.index, c.shards, c.first, c.last, c.next, c.count, c.bytes);
+    const std::string temp = path + ".tmp";
+    const int fd = open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) { return false; }
+    const bool ok = put(fd, text, size) && fsync(fd) == 0;
+    return close(fd) == 0 && ok && std::rename(temp.c_str(), path.c_str()) == 0;
+}
+
+/**
+ * Дописывает в конец файла результаты части перебора, проверяя, что файл
+ * части имеет ровно ожидаемую длину и содержит только многочлены степени
+ * degree с ненулевым свободным членом, т.е. не повреждён и не дополнен нулями.
+ * @param[in] path имя копируемого файла.
+ * @param[in] out файл, открытый на запись.
+ * @param[in] bytes число копируемых байт, кратное 8.
+ * @param[in] degree степень многочленов.
+ * @return скопированы ли все байты и корректны ли все многочлены.
+ */
+[[nodiscard]]
+bool Shard::copy(const std::string &path, const int out, uint_fast64_t bytes, const uint_fast8_t degree) noexcept {
+    const int in = open(path.c_str(), O_RDONLY);
+    if (in < 0) { return false; }
+    struct stat st{};
+    bool ok = fstat(in, &st) == 0 && static_cast<uint_fast64_t>(st.st_size) == bytes && bytes % 8 == 0;
+    std::vector<uint64_t> buffer(1u << 17u);
+    const std::size_t capacity = 8 * buffer.size();
+    std::size_t filled = 0;
+    while (ok && bytes > 0) {
+        const std::size_t want = bytes < capacity - filled ? bytes : capacity - filled;
+        const ssize_t n = ::read(in, reinterpret_cast<char *>(buffer.data()) + filled, want);
+        if (n < 0 && errno == EINTR) { continue; }
+        ok = n > 0;
+        if (!ok) { break; }
+        bytes -= n;
+        filled += n;
+        // многочлены проверяются только целиком, остаток ждёт следующего чтения
+        const std::size_t whole = filled / 8;
+        for (std::size_t i = 0; ok && i < whole; ++i) {
+            ok = buffer[i] >> degree == 1 && (buffer[i] & 1u);
+        }
+        ok = ok && put(out, buffer.data(), 8 * whole);
+        filled -= 8 * whole;
+        if (filled) { buffer[0] = buffer[whole]; }
+    }
+    close(in);
+    return ok;
+}
+
+/**
+ * Выполняет часть index из shards полного перебора многочленов степени
+ * degree (см. Enumerator::Count(degree, first, last)): 2^(degree-1)
+ * кандидатов делятся на shards диапазонов почти равной длины, которые
+ * можно перебирать независимыми процессами на разных машинах.
+ * Кандидаты проверяются порциями, и не реже чем раз в interval секунд
+ * в файл prefix.degree.index-of-shards.ckpt сохраняется контрольная точка:
+ * диапазон части, номер первого непроверенного кандидата, число найденных
+ * неприводимых многочленов и длина файла результатов. Если контрольная
+ * точка уже есть, перебор продолжается с неё, а файл результатов
+ * обрезается до сохранённой длины, т.е. многочлены, найденные после
+ * последней точки, ищутся заново; если же файл результатов короче
+ * сохранённой длины (утерян или обрезан), часть перебирается с начала.
+ * Найденные многочлены (если polys) дописываются в файл
+ * prefix.degree.index-of-shards.bin 64-битными числами в порядке нахождения; файл сбрасывается на диск перед каждой точкой.
+ * @param[in] prefix общее начало имён файлов перебора.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] index номер части, от 0 до shards - 1.
+ * @param[in] shards число частей, больше 0.
+ * @param[in] polys записывать ли найденные многочлены.
+ * @param[in] threads число потоков, 0 - по числу потоков, доступных в системе.
+ * @param[in] interval наибольшее время между контрольными точками в секундах.
+ * @return завершена ли часть, false при некорректных параметрах, ошибке
+ * ввода-вывода или если контрольная точка не соответствует параметрам
+ * (в том числе другому значению polys).
+ */
+[[nodiscard]]
+bool Shard::Run(
+        const char *const prefix, const uint_fast8_t degree, const uint_fast64_t index,
+        const uint_fast64_t shards, const bool polys, const uint_fast8_t threads, const unsigned interval
+) noexcept {
+    if (degree == 0 || degree > 63 || shards == 0 || index >= shards) { return false; }
+    const unsigned __int128 total = 1ull << (degree - 1u);
+    Checkpoint c{index, shards, static_cast<uint_fast64_t>(total * index / shards),
+                 static_cast<uint_fast64_t>(total * (index + 1) / shards), 0, 0, 0, degree};
+    c.next = c.first;
+    Checkpoint saved{};
+    if (Load(prefix, degree, index, shards, saved)) {
+        if (saved.first != c.first || saved.last != c.last) { return false; }
+        c = saved;
+    }
+    if (c.bytes != (polys ? 8 * c.count : 0)) { return false; }
+
+    const std::string base = name(prefix, degree, index, shards);
+    int out = -1;
+    if (polys) {
+        out = open((base + ".bin").c_str(), O_WRONLY | O_CREAT, 0644);
+        if (out < 0) { return false; }
+        struct stat st{};
+        if (fstat(out, &st)) {
+            close(out);
+            return false;
+        }
+        if (static_cast<uint_fast64_t>(st.st_size) < c.bytes) {
+            // результаты до контрольной точки утеряны: часть перебирается заново
+            c.next = c.first;
+            c.count = 0;
+            c.bytes = 0;
+        }
+        if (ftruncate(out, static_cast<off_t>(c.bytes)) || lseek(out, static_cast<off_t>(c.bytes), SEEK_SET) < 0) {
+            close(out);
+            return false;
+        }
+    }
+
+    Enumerator enumerator(threads);
+    std::vector<uint_fast64_t> found;
+    const auto collect = [&found](const uint_fast64_t p) { found.push_back(p); };
+    auto saveTime = std::chrono::steady_clock::now();
+    bool ok = true;
+    while (ok && c.next < c.last) {
+        const uint_fast64_t end = c.last - c.next > slice ? c.next + slice : c.last;
+        if (polys) {
+            found.clear();
+            c.count += enumerator.Enumerate(degree, c.next, end, collect);
+            ok = put(out, found.data(), 8 * found.size());
+            c.bytes += 8 * found.size();
+        } else {
+            c.count += enumerator.Count(degree, c.next, end);
+        }
+        c.next = end;
+        const auto now = std::chrono::steady_clock::now();
+        if (c.next < c.last && now - saveTime >= std::chrono::seconds(interval)) {
+            // точка не должна ссылаться на результаты, которых нет на диске
+            ok = ok && (!polys || fsync(out) == 0) && save(base + ".ckpt", c);
+            saveTime = now;
+        }
+    }
+    // завершённая часть сохраняется всегда, даже если её диапазон пуст
+    ok = ok && (!polys || fsync(out) == 0) && save(base + ".ckpt", c);
+    if (polys) { ok = close(out) == 0 && ok; }
+    return ok;
+}
+
+/**
+ * Читает контрольную точку части перебора (см. Run).
+ * @param[in] prefix общее начало имён файлов перебора.
+ * @param[in] degree степень многочленов.
+ * @param[in] index номер части.
+ * @param[in] shards число частей.
+ * @param[out] c состояние части перебора.
+ * @return прочитана ли контрольная точка, false если её нет,
+ * она повреждена или записана для других параметров.
+ */
+[[nodiscard]]
+bool Shard::Load(
+        const char *const prefix, const uint_fast8_t degree, const uint_fast64_t index,
+        const uint_fast64_t shards, Checkpoint &c
+) noexcept {
+    const int fd = open((name(prefix, degree, index, shards) + ".ckpt").c_str(), O_RDONLY);
+    if (fd < 0) { return false; }
+    char text[512];
+    std::size_t size = 0;
+    while (size + 1 < sizeof(text)) {
+        const ssize_t n = ::read(fd, text + size, sizeof(text) - 1 - size);
+        if (n < 0 && errno == EINTR) { continue; }
+        if (n <= 0) { break; }
+        size += n;
+    }
+    close(fd);
+    text[size] = '\0';
+    unsigned d = 0;
+    const int fields = std::sscanf(
+            text, "degree %u shard %" SCNuFAST64 " %" SCNuFAST64 " first %" SCNuFAST64 " last %" SCNuFAST64
+                  " next %" SCNuFAST64 " count %" SCNuFAST64 " bytes %" SCNuFAST64,
+            &d, &c.index, &c.shards, &c.first, &c.last, &c.next, &c.count, &c.bytes);
+    c.degree = d;
+    return fields == 8 && d == degree && c.index == index && c.shards == shards &&
+           c.first <= c.next && c.next <= c.last;
+}
+
+/**
+ * Объединяет результаты всех частей перебора (см. Run): проверяет, что все
+ * части завершены, а их диапазоны без пропусков и пересечений покрывают
+ * всех кандидатов, складывает числа найденных многочленов и сверяет сумму
+ * с формулой Гаусса (см. Polynomial::Count). Если задан out, в него
+ * по порядку частей записываются найденные многочлены (для степени 1
+ * в конце добавляется x, который не входит в перебор); у каждой части
+ * файл результатов должен содержать ровно count многочленов степени
+ * degree с ненулевым свободным членом.
+ * @param[in] prefix общее начало имён файлов перебора.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] shards число частей.
+ * @param[in] out имя файла для всех найденных многочленов, nullptr - не записывать.
+ * @param[out] count число неприводимых многочленов по всем прочитанным частям.
+ * @return завершён ли перебор, и совпадает ли результат с формулой Гаусса.
+ */
+[[nodiscard]]
+bool Shard::Merge(
+        const char *const prefix, const uint_fast8_t degree, const uint_fast64_t shards,
+        const char *const out, uint_fast64_t &count
+) noexcept {
+    count = 0;
+    if (degree == 0 || degree > 63 || shards == 0) { return false; }
+    const int fd = out ? open(out, O_WRONLY | O_CREAT | O_TRUNC, 0644) : -1;
+    if (out && fd < 0) { return false; }
+    uint_fast64_t covered = 0;
+    bool ok = true;
+    for (uint_fast64_t i = 0; ok && i < shards; ++i) {
+        Checkpoint c{};
+        ok = Load(prefix, degree, i, shards, c) && c.first == covered && c.next == c.last;
+        if (!ok) { break; }
+        covered = c.last;
+        count += c.count;
+        if (out) { ok = c.bytes == 8 * c.count && copy(name(prefix, degree, i, shards) + ".bin", fd, c.bytes, degree); }
+    }
+    ok = ok && covered == 1ull << (degree - 1u);
+    if (degree == 1) {
+        // x не попадает под перебор, т.к. у него нулевой свободный член
+        const uint_fast64_t x = 2;
+        ++count;
+        if (out) { ok = ok && put(fd, &x, sizeof(x)); }
+    }
+    if (out) {
+        const bool synced = fsync(fd) == 0;
+        ok = close(fd) == 0 && synced && ok;
+    }
+    return ok && count == Polynomial<>::Count(degree);
+}
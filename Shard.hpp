@@ -0,0 +1,52 @@
+/**
+ * @file    Shard.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_SHARD_HPP
+#define BERLEKAMP_SHARD_HPP
+
+#include <cstdint>
+#include <string>
+
+class Shard {
+public:
+    /// состояние части перебора, сохраняемое в контрольной точке
+    struct Checkpoint {
+        uint_fast64_t index;
+        uint_fast64_t shards;
+        uint_fast64_t first;
+        uint_fast64_t last;
+        uint_fast64_t next;
+        uint_fast64_t count;
+        uint_fast64_t bytes;
+        uint_fast8_t degree;
+    };
+
+private:
+    [[nodiscard]] static
+    std::string name(const char *, uint_fast8_t, uint_fast64_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    bool save(const std::string &, const Checkpoint &) noexcept;
+
+    [[nodiscard]] static
+    bool copy(const std::string &, int, uint_fast64_t, uint_fast8_t) noexcept;
+
+public:
+    [[nodiscard]] static
+    bool Run(const char *, uint_fast8_t, uint_fast64_t, uint_fast64_t, bool,
+             uint_fast8_t = 0, unsigned = 60) noexcept;
+
+    [[nodiscard]] static
+    bool Load(const char *, uint_fast8_t, uint_fast64_t, uint_fast64_t, Checkpoint &) noexcept;
+
+    [[nodiscard]] static
+    bool Merge(const char *, uint_fast8_t, uint_fast64_t, const char *, uint_fast64_t &) noexcept;
+};
+
+#endif //BERLEKAMP_SHARD_HPP
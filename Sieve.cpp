@@ -0,0 +1,262 @@
+/**
+ * @file    Sieve.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <new>
+#include <thread>
+#include <pthread.h>
+
+#include "Clmul.hpp"
+#include "Sieve.hpp"
+
+/**
+ * Наибольшая степень, для которой строится таблица: 2^40 бит - 128 ГиБ.
+ */
+static const uint_fast8_t maxDegree = 40;
+
+/**
+ * Двоичный логарифм числа многочленов в части таблицы, обрабатываемой
+ * за раз: 2^21 бит нечётных многочленов (256 КиБ) помещаются в кэш L2.
+ */
+static const uint_fast8_t segmentShift = 22;
+
+/**
+ * Биты b = 0,...,63, у которых чётное число единиц.
+ */
+static const uint64_t evenWeight = 0x96'69'69'96'69'96'96'69ull;
+
+/**
+ * Создаёт пустую таблицу неприводимых многочленов.
+ * @param[in] threadsNum число потоков, используемых при построении,
+ * 0 - по числу потоков, доступных в системе.
+ */
+Sieve::Sieve(uint_fast8_t threadsNum) noexcept :
+        taken(0), words(0), segments(0), degree(0), shift(0), threadsNum(threadsNum) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        this->threadsNum = cores > 0 ? cores : 1;
+    }
+}
+
+/**
+ * Заполняет часть таблицы номер t многочленами, не делящимися на x + 1.
+ * Бит i таблицы соответствует нечётному многочлену 2i + 1, у которого
+ * на одну единицу больше, чем у i; многочлен делится на x + 1 тогда
+ * и только тогда, когда число его единиц чётно, поэтому слово g
+ * таблицы - evenWeight или его дополнение в зависимости от чётности g.
+ * @param[in] t номер части таблицы.
+ */
+void Sieve::fill(const uint_fast64_t t) noexcept {
+    const uint_fast64_t size = 1ull << static_cast<uint_fast8_t>(shift - 7u), first = t * size;
+    uint64_t *const seg = bits.get() + first;
+    for (uint_fast64_t k = 0; k < size; ++k) {
+        seg[k] = __builtin_parityll(first + k) ? ~evenWeight : evenWeight;
+    }
+}
+
+/**
+ * Вычёркивает в части таблицы номер t все кратные q * r неприводимого
+ * многочлена q степени e с нечётным r. Коэффициенты q * r начиная
+ * с x^shift зависят только от коэффициентов r начиная с x^(shift-e),
+ * поэтому у всех кратных, попадающих в часть t, старшая часть r одна
+ * и та же: частное от деления t * x^e на q, найденное методом Барретта
+ * (см. Clmul). Младшие shift - e коэффициентов r перебираются в порядке
+ * кода Грея, так что каждое следующее кратное отличается от предыдущего
+ * на q * x^b и вычисляется одной операцией.
+ * @param[in] t номер части таблицы.
+ * @param[in] f неприводимый многочлен степени меньше shift.
+ */
+void Sieve::strike(const uint_fast64_t t, const Factor &f) noexcept {
+    const uint_fast8_t j = shift - f.degree;
+    const auto hi = t ? static_cast<uint_fast64_t>(Clmul::Product(t, f.mu) >> (63u - f.degree)) : 0;
+    uint64_t *const seg = bits.get() + (t << static_cast<uint_fast8_t>(shift - 7u));
+    const uint_fast64_t offset = t << static_cast<uint_fast8_t>(shift - 1u);
+    uint_fast64_t v = (static_cast<uint_fast64_t>(Clmul::Product(f.q, hi)) << j) ^ f.q, i;
+    // при t = 0 первое кратное - сам q
+    if (t) {
+        i = (v >> 1u) - offset;
+        seg[i >> 6u] &= ~(1ull << (i & 63u));
+    }
+    const uint_fast64_t count = 1ull << static_cast<uint_fast8_t>(j - 1u);
+    for (uint_fast64_t k = 1; k < count; ++k) {
+        v ^= f.q << static_cast<uint_fast8_t>(__builtin_ctzll(k) + 1);
+        i = (v >> 1u) - offset;
+        seg[i >> 6u] &= ~(1ull << (i & 63u));
+    }
+}
+
+/**
+ * Строит часть таблицы номер t: вычёркивает кратные всех неприводимых
+ * многочленов степени не больше degree / 2.
+ * @param[in] t номер части таблицы, больше 0.
+ */
+void Sieve::segment(const uint_fast64_t t) noexcept {
+    fill(t);
+    for (const Factor &f : factors) { strike(t, f); }
+}
+
+/**
+ * Цикл рабочего потока: строит части таблицы по очереди с другими потоками.
+ * @param arg экземпляр Sieve.
+ * @return nullptr после построения всех частей.
+ */
+void *Sieve::work(void *arg) noexcept {
+    auto &s = *static_cast<Sieve *>(arg);
+    for (uint_fast64_t t = s.taken++; t < s.segments; t = s.taken++) { s.segment(t); }
+    return nullptr;
+}
+
+/**
+ * Строит таблицу неприводимости всех многочленов степени от 1 до n
+ * решетом Эратосфена: многочлен степени не больше n приводим тогда
+ * и только тогда, когда делится на неприводимый многочлен степени
+ * не больше n / 2. Хранятся только нечётные многочлены (остальные,
+ * кроме x, делятся на x), по биту на многочлен: 2^n бит, 2 ГиБ для n = 34.
+ * Таблица делится на части, помещающиеся в кэш. Первая часть содержит
+ * все многочлены степени до n / 2, она строится первой, и найденные
+ * в ней неприводимые многочлены вычёркивают кратные в остальных частях,
+ * которые потоки разбирают по очереди; вызывающий поток также участвует.
+ * @param[in] n наибольшая степень, от 1 до 40.
+ * @return построена ли таблица, false если n задано неверно
+ * или не удалось выделить память.
+ */
+[[nodiscard]]
+bool Sieve::Build(const uint_fast8_t n) noexcept {
+    bits.reset();
+    factors.clear();
+    degree = 0;
+    words = 0;
+    if (n == 0 || n > maxDegree) { return false; }
+    shift = n + 1u < 7u ? 7u : (n + 1u < segmentShift ? n + 1u : segmentShift);
+    segments = 1ull << static_cast<uint_fast8_t>(n + 1u - (n + 1u < shift ? n + 1u : shift));
+    words = segments << static_cast<uint_fast8_t>(shift - 7u);
+    bits.reset(new(std::nothrow) uint64_t[words]);
+    if (!bits) {
+        words = 0;
+        return false;
+    }
+    degree = n;
+
+    fill(0);
+    bits[0] &= ~1ull; // 1 не является неприводимым
+    bits[0] |= 2ull;  // x + 1 неприводим, хотя и делится на x + 1
+    for (uint_fast64_t p = 5; p >> static_cast<uint_fast8_t>(n / 2u + 1u) == 0; p += 2) {
+        if (!((bits[p >> 7u] >> ((p >> 1u) & 63u)) & 1u)) { continue; }
+        Factor f{p, 0, static_cast<uint_fast8_t>(63u - __builtin_clzll(p))};
+        // mu = x^63 / q для деления методом Барретта
+        uint_fast64_t r = 1ull << 63u;
+        for (uint_fast8_t i = 63; i >= f.degree; --i) {
+            if (!((r >> i) & 1u)) { continue; }
+            r ^= p << static_cast<uint_fast8_t>(i - f.degree);
+            f.mu |= 1ull << static_cast<uint_fast8_t>(i - f.degree);
+        }
+        factors.push_back(f);
+        strike(0, f);
+    }
+    if (n < 6) { bits[0] &= (1ull << (1u << n)) - 1ull; }
+
+    taken = 1;
+    std::vector<pthread_t> threads(threadsNum);
+    // если поток не удалось создать, его части разберут остальные
+    std::vector<bool> started(threadsNum, false);
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        started[i] = pthread_create(&threads[i], nullptr, &work, this) == 0;
+    }
+    work(this);
+    for (uint_fast8_t i = 1; i < threadsNum; ++i) {
+        if (started[i]) { pthread_join(threads[i], nullptr); }
+    }
+    return true;
+}
+
+/**
+ * @return наибольшая степень построенной таблицы, 0 если таблица не построена.
+ */
+[[nodiscard]]
+uint_fast8_t Sieve::Degree() const noexcept {
+    return degree;
+}
+
+/**
+ * Определяет по таблице, является ли многочлен неприводимым.
+ * @param[in] p многочлен степени не больше Degree().
+ * @return является ли p неприводимым, false для многочленов большей степени.
+ */
+[[nodiscard]]
+bool Sieve::IsIrredusible(const uint_fast64_t p) const noexcept {
+    if (!bits || p >> degree > 1) { return false; }
+    if (p == 2) { return true; }
+    return (p & 1u) && ((bits[p >> 7u] >> ((p >> 1u) & 63u)) & 1u);
+}
+
+/**
+ * @param[in] b первый бит таблицы.
+ * @param[in] e последний бит таблицы (не включительно).
+ * @return число единичных бит таблицы от b до e.
+ */
+[[nodiscard]]
+uint_fast64_t Sieve::count(uint_fast64_t b, const uint_fast64_t e) const noexcept {
+    uint_fast64_t res = 0;
+    for (; b < e && (b & 63u); ++b) { res += (bits[b >> 6u] >> (b & 63u)) & 1u; }
+    for (; b + 64 <= e; b += 64) { res += __builtin_popcountll(bits[b >> 6u]); }
+    for (; b < e; ++b) { res += (bits[b >> 6u] >> (b & 63u)) & 1u; }
+    return res;
+}
+
+/**
+ * Подсчитывает по таблице неприводимые многочлены заданной степени,
+ * результат совпадает с формулой Гаусса (см. Polynomial::Count).
+ * @param[in] d степень, от 1 до Degree().
+ * @return число неприводимых многочленов степени d, 0 если d задано неверно.
+ */
+[[nodiscard]]
+uint_fast64_t Sieve::Count(const uint_fast8_t d) const noexcept {
+    if (!bits || d == 0 || d > degree) { return 0; }
+    // нечётные многочлены степени d - биты от 2^(d-1) до 2^d, x учитывается отдельно
+    return count(1ull << static_cast<uint_fast8_t>(d - 1u), 1ull << d) + (d == 1);
+}
+
+/**
+ * Находит по таблице следующий неприводимый многочлен: многочлены
+ * упорядочены как числа, т.е. по степени, а внутри степени лексикографически.
+ * @param[in] p многочлен.
+ * @return наименьший неприводимый многочлен больше p, 0 если его степень
+ * больше Degree().
+ */
+[[nodiscard]]
+uint_fast64_t Sieve::Next(const uint_fast64_t p) const noexcept {
+    if (!bits || p >> degree > 1) { return 0; }
+    if (p < 2) { return 2; }
+    const uint_fast64_t end = 1ull << degree;
+    for (uint_fast64_t i = (p + 1u) >> 1u; i < end; i = (i | 63u) + 1u) {
+        const uint64_t w = bits[i >> 6u] >> (i & 63u);
+        if (!w) { continue; }
+        i += __builtin_ctzll(w);
+        return i < end ? 2 * i + 1 : 0;
+    }
+    return 0;
+}
+
+/**
+ * Таблица неприводимости: бит b слова w соответствует многочлену
+ * 2 * (64w + b) + 1 и равен 1, если многочлен неприводим. Чётные
+ * многочлены не хранятся, из них неприводим только x.
+ * @return слова таблицы, nullptr если таблица не построена.
+ */
+[[nodiscard]]
+const uint64_t *Sieve::Data() const noexcept {
+    return bits.get();
+}
+
+/**
+ * @return число 64-битных слов таблицы (см. Data).
+ */
+[[nodiscard]]
+std::size_t Sieve::Size() const noexcept {
+    return words;
+}
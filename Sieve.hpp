@@ -0,0 +1,74 @@
+/**
+ * @file    Sieve.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_SIEVE_HPP
+#define BERLEKAMP_SIEVE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Sieve {
+    /// неприводимый многочлен, кратные которого вычёркиваются
+    struct Factor {
+        uint_fast64_t q;
+        uint_fast64_t mu;
+        uint_fast8_t degree;
+    };
+
+    std::unique_ptr<uint64_t[]> bits;
+    std::vector<Factor> factors;
+    std::atomic<uint_fast64_t> taken;
+    std::size_t words;
+    uint_fast64_t segments;
+    uint_fast8_t degree;
+    uint_fast8_t shift;
+    uint_fast8_t threadsNum;
+
+    static
+    void *work(void *) noexcept;
+
+    void fill(uint_fast64_t) noexcept;
+
+    void segment(uint_fast64_t) noexcept;
+
+    void strike(uint_fast64_t, const Factor &) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t count(uint_fast64_t, uint_fast64_t) const noexcept;
+
+public:
+    explicit
+    Sieve(uint_fast8_t = 0) noexcept;
+
+    [[nodiscard]]
+    bool Build(uint_fast8_t) noexcept;
+
+    [[nodiscard]]
+    uint_fast8_t Degree() const noexcept;
+
+    [[nodiscard]]
+    bool IsIrredusible(uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Count(uint_fast8_t) const noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Next(uint_fast64_t) const noexcept;
+
+    [[nodiscard]]
+    const uint64_t *Data() const noexcept;
+
+    [[nodiscard]]
+    std::size_t Size() const noexcept;
+};
+
+#endif //BERLEKAMP_SIEVE_HPP
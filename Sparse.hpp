@@ -0,0 +1,282 @@
+/**
+ * @file    Sparse.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_SPARSE_HPP
+#define BERLEKAMP_SPARSE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+template<std::size_t Words>
+class Sparse {
+    using Bits = std::array<uint_fast64_t, Words>;
+    using Wide = std::array<uint_fast64_t, 2 * Words>;
+
+    uint_fast16_t degree;
+    std::array<uint_fast16_t, 3> k;
+    uint_fast8_t terms;
+
+    [[nodiscard]] static
+    uint_fast64_t spread(uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    bool coprime(Bits, Bits) noexcept;
+
+    [[nodiscard]]
+    Bits dense() const noexcept;
+
+    [[nodiscard]]
+    Bits sqr(const Bits &) const noexcept;
+
+public:
+    explicit
+    Sparse(uint_fast16_t) noexcept;
+
+    [[nodiscard]] static
+    bool Swan(uint_fast16_t, uint_fast16_t) noexcept;
+
+    [[nodiscard]]
+    bool Next() noexcept;
+
+    [[nodiscard]]
+    bool IsIrredusible() const noexcept;
+
+    [[nodiscard]]
+    std::vector<uint_fast16_t> Exponents() const noexcept;
+};
+
+/**
+ * Создаёт перечислитель разреженных многочленов степени n над полем GF[2]:
+ * трёхчленов x^n + x^k + 1 и пятичленов x^n + x^k3 + x^k2 + x^k1 + 1.
+ * До первого вызова Next многочлен не задан.
+ * @param[in] n степень многочленов, от 2 до 64 * Words - 1.
+ */
+template<std::size_t Words>
+Sparse<Words>::Sparse(const uint_fast16_t n) noexcept : degree(n), k(), terms(0) {}
+
+/**
+ * Теорема Суона: при n > k > 0 и ровно одном нечётном из n, k трёхчлен
+ * x^n + x^k + 1 имеет чётное число неприводимых множителей, т.е. приводим, если
+ * n чётно, n != 2k и nk/2 = 0 или 1 (mod 4), либо
+ * n нечётно, k не делит 2n и n = ±3 (mod 8), либо
+ * n нечётно, k делит 2n и n = ±1 (mod 8).
+ * Трёхчлен с чётными n и k - квадрат, а при нечётных n и k теорема
+ * применяется к взаимному трёхчлену x^n + x^(n-k) + 1.
+ * В частности, при n, кратном 8, неприводимых трёхчленов нет.
+ * @param[in] n степень трёхчлена.
+ * @param[in] k степень среднего члена, 0 < k < n.
+ * @return доказывает ли теорема приводимость трёхчлена.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Sparse<Words>::Swan(const uint_fast16_t n, uint_fast16_t k) noexcept {
+    if (n % 2 == 0 && k % 2 == 0) { return true; }
+    if (n % 2 == 1 && k % 2 == 1) { k = n - k; }
+    if (n % 2 == 0) { return n != 2 * k && (n / 2 * k) % 4 < 2; }
+    const uint_fast16_t m = n % 8;
+    if ((2 * n) % k != 0) { return m == 3 || m == 5; }
+    return m == 1 || m == 7;
+}
+
+/**
+ * Переходит к следующему кандидату в каноническом порядке: сначала
+ * трёхчлены по возрастанию k (только k <= n/2, т.к. трёхчлен неприводим
+ * вместе со взаимным x^n + x^(n-k) + 1), затем пятичлены по возрастанию
+ * k3, k2, k1 (n > k3 > k2 > k1 > 0). Трёхчлены, приводимость которых
+ * следует из теоремы Суона, и пятичлены с чётными степенями (квадраты)
+ * пропускаются без проверки.
+ * @return есть ли следующий кандидат.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Sparse<Words>::Next() noexcept {
+    if (terms == 0) {
+        terms = 1;
+        k = {0, 0, 0};
+    }
+    if (terms == 1) {
+        for (++k[0]; 2 * k[0] <= degree; ++k[0]) {
+            if (!Swan(degree, k[0])) { return true; }
+        }
+        terms = 3;
+        k = {3, 2, 0};
+    }
+    do {
+        if (++k[2] == k[1]) {
+            k[2] = 1;
+            if (++k[1] == k[0]) {
+                k[1] = 2;
+                if (++k[0] >= degree) { return false; }
+            }
+        }
+    } while (degree % 2 == 0 && k[0] % 2 == 0 && k[1] % 2 == 0 && k[2] % 2 == 0);
+    return k[0] < degree;
+}
+
+/**
+ * @return степени ненулевых членов текущего многочлена по убыванию, включая n и 0.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+std::vector<uint_fast16_t> Sparse<Words>::Exponents() const noexcept {
+    std::vector<uint_fast16_t> res{degree};
+    res.insert(res.end(), k.begin(), k.begin() + terms);
+    res.push_back(0);
+    return res;
+}
+
+/**
+ * @return текущий многочлен в плотном представлении.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+typename Sparse<Words>::Bits Sparse<Words>::dense() const noexcept {
+    Bits res{};
+    res[degree >> 6u] |= 1ull << (degree & 63u);
+    for (uint_fast8_t i = 0; i < terms; ++i) {
+        res[k[i] >> 6u] |= 1ull << (k[i] & 63u);
+    }
+    res[0] |= 1u;
+    return res;
+}
+
+/**
+ * Раздвигает младшие 32 бита числа, вставляя нулевой бит после каждого:
+ * над полем GF[2] (sum a_i x^i)^2 = sum a_i x^(2i).
+ * @param[in] a младшие 32 коэффициента многочлена.
+ * @return квадрат многочлена.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+uint_fast64_t Sparse<Words>::spread(uint_fast64_t a) noexcept {
+    a &= 0x00'00'00'00'FF'FF'FF'FFull;
+    a = (a | (a << 16u)) & 0x00'00'FF'FF'00'00'FF'FFull;
+    a = (a | (a << 8u)) & 0x00'FF'00'FF'00'FF'00'FFull;
+    a = (a | (a << 4u)) & 0x0F'0F'0F'0F'0F'0F'0F'0Full;
+    a = (a | (a << 2u)) & 0x33'33'33'33'33'33'33'33ull;
+    a = (a | (a << 1u)) & 0x55'55'55'55'55'55'55'55ull;
+    return a;
+}
+
+/**
+ * Возводит многочлен в квадрат по модулю текущего разреженного многочлена.
+ * Приведение использует малое число ненулевых членов модуля:
+ * x^n = x^k3 + ... + 1, поэтому часть квадрата hi * x^n, лежащая выше
+ * степени n, заменяется суммой hi, сдвинутой на каждую степень модуля,
+ * т.е. двумя-четырьмя сдвигами с исключающим или вместо деления.
+ * Пока средние степени не больше n/2, хватает двух таких шагов.
+ * @param[in] a многочлен степени меньше n.
+ * @return a^2 по модулю текущего многочлена.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+typename Sparse<Words>::Bits Sparse<Words>::sqr(const Bits &a) const noexcept {
+    Wide c;
+    for (std::size_t i = 0; i < Words; ++i) {
+        c[2 * i] = spread(a[i]);
+        c[2 * i + 1] = spread(a[i] >> 32u);
+    }
+    const std::size_t w = degree >> 6u;
+    const uint_fast8_t b = degree & 63u;
+    Bits hi;
+    bool more = true;
+    while (more) {
+        // hi = c / x^n, c = c mod x^n
+        more = false;
+        for (std::size_t i = 0; i < Words; ++i) {
+            hi[i] = w + i < 2 * Words ? c[w + i] >> b : 0;
+            if (b && w + i + 1 < 2 * Words) { hi[i] |= c[w + i + 1] << (64u - b); }
+            more |= hi[i] != 0;
+        }
+        if (!more) { break; }
+        c[w] &= (1ull << b) - 1;
+        for (std::size_t i = w + 1; i < 2 * Words; ++i) { c[i] = 0; }
+        // c += hi * (x^k3 + ... + 1)
+        for (uint_fast8_t t = 0; t <= terms; ++t) {
+            const uint_fast16_t s = t < terms ? k[t] : 0;
+            const std::size_t sw = s >> 6u;
+            const uint_fast8_t sb = s & 63u;
+            for (std::size_t i = 0; i < Words && sw + i < 2 * Words; ++i) {
+                c[sw + i] ^= hi[i] << sb;
+                if (sb && sw + i + 1 < 2 * Words) { c[sw + i + 1] ^= hi[i] >> (64u - sb); }
+            }
+        }
+    }
+    Bits res;
+    for (std::size_t i = 0; i < Words; ++i) { res[i] = c[i]; }
+    return res;
+}
+
+/**
+ * Определяет, взаимно просты ли многочлены, бинарным алгоритмом
+ * (см. Polynomial<Words>::coprime).
+ * @param[in] p1 многочлен, не делящийся на x.
+ * @param[in] p2 второй многочлен.
+ * @return взаимно просты ли многочлены.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Sparse<Words>::coprime(Bits p1, Bits p2) noexcept {
+    const auto zero = [](const Bits &p) {
+        for (auto x : p) { if (x) { return false; } }
+        return true;
+    };
+    const auto less = [](const Bits &a, const Bits &b) {
+        for (std::size_t i = Words; i-- > 0;) {
+            if (a[i] != b[i]) { return a[i] < b[i]; }
+        }
+        return false;
+    };
+    while (!zero(p2)) {
+        while (!(p2[0] & 1u)) {
+            for (std::size_t i = 0; i + 1 < Words; ++i) { p2[i] = (p2[i] >> 1u) | (p2[i + 1] << 63u); }
+            p2[Words - 1] >>= 1u;
+        }
+        if (less(p2, p1)) { std::swap(p1, p2); }
+        for (std::size_t i = 0; i < Words; ++i) { p2[i] ^= p1[i]; }
+    }
+    for (std::size_t i = 1; i < Words; ++i) { if (p1[i]) { return false; } }
+    return p1[0] == 1;
+}
+
+/**
+ * Проверяет текущий многочлен на неприводимость тестом Рабина
+ * (см. Polynomial<1>::rabin): вычисляются u_i = x^(2^i) по модулю многочлена,
+ * i = 1,...,n, многочлен неприводим тогда и только тогда, когда u_n = x
+ * и gcd(u_(n/q) - x, f) = 1 для всех простых q, делящих n.
+ * Возведение в квадрат с разреженным приведением стоит O(Words) операций,
+ * поэтому проверка даже на степени 571 занимает доли миллисекунды
+ * против секунд для построения матрицы Берлекампа.
+ * @return является ли текущий многочлен неприводимым.
+ */
+template<std::size_t Words>
+[[nodiscard]]
+bool Sparse<Words>::IsIrredusible() const noexcept {
+    const auto prime = [](const uint_fast16_t q) {
+        for (uint_fast16_t d = 2; d * d <= q; ++d) { if (q % d == 0) { return false; } }
+        return true;
+    };
+    const Bits f = dense();
+    Bits x{}, u{};
+    x[0] = u[0] = 2; // x
+    for (uint_fast16_t i = 1; i <= degree; ++i) {
+        u = sqr(u);
+        if (i < degree && degree % i == 0 && prime(degree / i)) {
+            Bits g = u;
+            g[0] ^= 2u;
+            if (!coprime(f, g)) { return false; }
+        }
+    }
+    return u == x;
+}
+
+#endif //BERLEKAMP_SPARSE_HPP
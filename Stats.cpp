@@ -0,0 +1,193 @@
+/**
+ * @file    Stats.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#if defined(__x86_64__)
+#include <x86intrin.h>
+#define STATS_X86
+#endif
+
+#include <atomic>
+#include <chrono>
+#include <pthread.h>
+#include "Stats.hpp"
+
+/**
+ * Счётчики одного потока. Пишет в них только поток-владелец, поэтому
+ * обновление - это чтение и запись без атомарных операций над памятью,
+ * а атомарность нужна лишь для того, чтобы Collect мог читать их
+ * из другого потока.
+ */
+struct Stats::Local {
+    std::array<std::array<std::array<std::atomic<uint_fast64_t>, 3>, 64>, stages> slots;
+
+    Local() noexcept;
+
+    ~Local() noexcept;
+};
+
+/**
+ * Все живые счётчики потоков и сумма счётчиков завершившихся потоков.
+ * Создаётся при первом обращении и никогда не уничтожается, т.к. потоки
+ * могут завершаться после уничтожения статических объектов.
+ */
+struct Registry {
+    pthread_mutex_t mutex = PTHREAD_MUTEX_INITIALIZER;
+    std::vector<Stats::Local *> live;
+    Stats::Table retired{};
+};
+
+[[nodiscard]] static
+Registry &registry() noexcept {
+    static auto *const res = new Registry;
+    return *res;
+}
+
+/**
+ * Добавляет счётчики потока к таблице.
+ * @param[in,out] table таблица счётчиков.
+ * @param[in] local счётчики потока.
+ */
+static
+void accumulate(Stats::Table &table, const Stats::Local &local) noexcept {
+    for (std::size_t s = 0; s < Stats::stages; ++s) {
+        for (std::size_t d = 0; d < 64; ++d) {
+            const auto &slot = local.slots[s][d];
+            table[s][d].calls += slot[0].load(std::memory_order_relaxed);
+            table[s][d].rejected += slot[1].load(std::memory_order_relaxed);
+            table[s][d].cycles += slot[2].load(std::memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * Обнуляет счётчики и регистрирует их среди живых.
+ */
+Stats::Local::Local() noexcept {
+    for (auto &stage : slots) {
+        for (auto &slot : stage) {
+            for (auto &x : slot) { x.store(0, std::memory_order_relaxed); }
+        }
+    }
+    auto &r = registry();
+    pthread_mutex_lock(&r.mutex);
+    r.live.push_back(this);
+    pthread_mutex_unlock(&r.mutex);
+}
+
+/**
+ * При завершении потока переносит его счётчики в сумму завершившихся.
+ */
+Stats::Local::~Local() noexcept {
+    auto &r = registry();
+    pthread_mutex_lock(&r.mutex);
+    accumulate(r.retired, *this);
+    for (auto &p : r.live) {
+        if (p == this) {
+            p = r.live.back();
+            r.live.pop_back();
+            break;
+        }
+    }
+    pthread_mutex_unlock(&r.mutex);
+}
+
+#ifdef BERLEKAMP_STATS
+/**
+ * @return счётчики текущего потока, создаваемые при первом обращении
+ * и живущие до завершения потока.
+ */
+[[nodiscard]] static
+Stats::Local &local() noexcept {
+    thread_local Stats::Local res;
+    return res;
+}
+#endif
+
+/**
+ * @return счётчик тактов процессора (на x86-64) или наносекунд монотонных
+ * часов; имеет смысл только разность двух значений.
+ */
+[[nodiscard]]
+uint_fast64_t Stats::Clock() noexcept {
+#ifdef STATS_X86
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+/**
+ * Учитывает прохождение ступени проверки в счётчиках текущего потока.
+ * Без BERLEKAMP_STATS ничего не делает (и не вызывается макросами).
+ * @param[in] stage ступень проверки.
+ * @param[in] degree степень многочленов, от 1 до 63.
+ * @param[in] calls число многочленов, дошедших до ступени.
+ * @param[in] rejected из них отброшено на этой ступени.
+ * @param[in] cycles время ступени (см. Clock).
+ */
+void Stats::Add(
+        const Stage stage, const uint_fast8_t degree, const uint_fast64_t calls,
+        const uint_fast64_t rejected, const uint_fast64_t cycles
+) noexcept {
+#ifdef BERLEKAMP_STATS
+    auto &slot = local().slots[static_cast<std::size_t>(stage)][degree & 63u];
+    slot[0].store(slot[0].load(std::memory_order_relaxed) + calls, std::memory_order_relaxed);
+    slot[1].store(slot[1].load(std::memory_order_relaxed) + rejected, std::memory_order_relaxed);
+    slot[2].store(slot[2].load(std::memory_order_relaxed) + cycles, std::memory_order_relaxed);
+#else
+    static_cast<void>(stage), static_cast<void>(degree), static_cast<void>(calls),
+            static_cast<void>(rejected), static_cast<void>(cycles);
+#endif
+}
+
+/**
+ * @return счётчики текущего потока (см. Collect), nullptr без BERLEKAMP_STATS.
+ */
+[[nodiscard]]
+const Stats::Local *Stats::Current() noexcept {
+#ifdef BERLEKAMP_STATS
+    return &local();
+#else
+    return nullptr;
+#endif
+}
+
+/**
+ * Собирает счётчики всех потоков процесса, включая завершившиеся,
+ * накопленные с момента запуска. Счётчики работающих потоков читаются
+ * без их остановки, поэтому значения разных ступеней могут быть
+ * согласованы лишь приблизительно. Для замера отдельного участка
+ * следует вычесть таблицу, собранную перед ним.
+ * @return таблица счётчиков, нулевая без BERLEKAMP_STATS.
+ */
+[[nodiscard]]
+Stats::Table Stats::Collect() noexcept {
+    Table res{};
+    auto &r = registry();
+    pthread_mutex_lock(&r.mutex);
+    res = r.retired;
+    for (const auto *p : r.live) { accumulate(res, *p); }
+    pthread_mutex_unlock(&r.mutex);
+    return res;
+}
+
+/**
+ * Собирает счётчики заданных потоков (см. Current). Потоки должны быть живы.
+ * @param[in] locals счётчики потоков, nullptr пропускаются.
+ * @return таблица счётчиков, нулевая без BERLEKAMP_STATS.
+ */
+[[nodiscard]]
+Stats::Table Stats::Collect(const std::vector<const Local *> &locals) noexcept {
+    Table res{};
+    for (const auto *p : locals) {
+        if (p) { accumulate(res, *p); }
+    }
+    return res;
+}
@@ -0,0 +1,89 @@
+/**
+ * @file    Stats.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_STATS_HPP
+#define BERLEKAMP_STATS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+ * Счётчики ступеней проверки включаются определением BERLEKAMP_STATS
+ * (опция CMake -DBERLEKAMP_STATS=ON). Без него макросы ниже раскрываются
+ * в пустоту, а Stats::Collect возвращает нулевую таблицу.
+ */
+#ifdef BERLEKAMP_STATS
+/// запускает таймер name
+#define STATS_CLOCK(name) uint_fast64_t name = Stats::Clock()
+/// учитывает calls многочленов ступени stage, из них rejected отброшенных,
+/// со временем от предыдущей отметки таймера name, и перезапускает таймер
+#define STATS_LAP(name, stage, degree, calls, rejected) \
+    (Stats::Add(Stats::Stage::stage, (degree), (calls), (rejected), Stats::Clock() - (name)), \
+     (name) = Stats::Clock())
+#else
+#define STATS_CLOCK(name)
+#define STATS_LAP(name, stage, degree, calls, rejected)
+#endif
+
+class Stats {
+public:
+    /// ступени проверки неприводимости
+    enum class Stage : uint_fast8_t {
+        Prefilter,  ///< делители малой степени (Checker::Reject)
+        Derivative, ///< нулевая производная (алгоритм Берлекампа)
+        Gcd,        ///< общий делитель с производной (алгоритм Берлекампа)
+        Rank,       ///< матрица Берлекампа и её ранг
+        BenOr,      ///< шаги Бен-Ора (алгоритм Рабина)
+        Rabin,      ///< оставшиеся шаги алгоритма Рабина
+        Batch,      ///< группы Batch::Lanes() многочленов
+        Block,      ///< блок кандидатов рабочего потока генератора
+    };
+
+    /// число ступеней
+    static constexpr std::size_t stages = 8;
+
+    /// собираются ли счётчики в данной сборке
+#ifdef BERLEKAMP_STATS
+    static constexpr bool enabled = true;
+#else
+    static constexpr bool enabled = false;
+#endif
+
+    /// счётчики одной ступени для одной степени
+    struct Counter {
+        uint_fast64_t calls;    ///< число многочленов, дошедших до ступени
+        uint_fast64_t rejected; ///< из них отброшено на этой ступени
+        uint_fast64_t cycles;   ///< суммарное время ступени в тактах
+    };
+
+    /// счётчики по ступеням и степеням: Table[stage][degree]
+    using Table = std::array<std::array<Counter, 64>, stages>;
+
+    /// счётчики одного потока
+    struct Local;
+
+    [[nodiscard]] static
+    uint_fast64_t Clock() noexcept;
+
+    static
+    void Add(Stage, uint_fast8_t, uint_fast64_t, uint_fast64_t, uint_fast64_t) noexcept;
+
+    [[nodiscard]] static
+    const Local *Current() noexcept;
+
+    [[nodiscard]] static
+    Table Collect() noexcept;
+
+    [[nodiscard]] static
+    Table Collect(const std::vector<const Local *> &) noexcept;
+};
+
+#endif //BERLEKAMP_STATS_HPP
@@ -0,0 +1,400 @@
+/**
+ * @file    Verifier.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Batch.hpp"
+#include "Verifier.hpp"
+
+/// результаты проверки отдельного многочлена
+enum : uint_fast8_t { reducible = 0, irreducible = 1, invalid = 2, pending = 3 };
+
+/**
+ * Создаёт проверщик потока многочленов. Рабочие потоки запускаются
+ * на время каждого вызова Run.
+ * @param[in] threads число рабочих потоков,
+ * 0 - по числу потоков, доступных в системе.
+ * @param[in] binary формат входа и выхода (см. Run).
+ */
+Verifier::Verifier(uint_fast8_t threads, const bool binary) noexcept :
+        mutex(PTHREAD_MUTEX_INITIALIZER), hasWork(PTHREAD_COND_INITIALIZER),
+        hasResult(PTHREAD_COND_INITIALIZER), hasSpace(PTHREAD_COND_INITIALIZER),
+        read(0), taken(0), written(0), count(0), threadsNum(threads), output(-1),
+        binary(binary), finished(false), failed(false) {
+    if (threadsNum == 0) {
+        static const uint_fast8_t cores = std::thread::hardware_concurrency();
+        threadsNum = cores > 0 ? cores : 1;
+    }
+}
+
+/**
+ * Освобождает объекты синхронизации.
+ */
+Verifier::~Verifier() noexcept {
+    pthread_cond_destroy(&hasSpace);
+    pthread_cond_destroy(&hasResult);
+    pthread_cond_destroy(&hasWork);
+    pthread_mutex_destroy(&mutex);
+}
+
+/**
+ * Разбирает порцию входных данных. В текстовом формате каждая строка -
+ * многочлен в шестнадцатеричном виде (не более 16 цифр, необязательный
+ * префикс 0x, пробелы по краям игнорируются), строки, которые
+ * не удалось разобрать, помечаются как некорректные.
+ * В двоичном формате каждые 8 байт - многочлен в порядке байт машины.
+ * @param[in,out] w рабочий поток, в буферы которого записывается результат.
+ * @param[in] c порция входных данных.
+ */
+void Verifier::parse(Worker &w, const Chunk &c) noexcept {
+    w.polys.clear();
+    w.verdict.clear();
+    if (binary) {
+        for (const char *p = c.begin; p + 8 <= c.end; p += 8) {
+            uint64_t x;
+            std::memcpy(&x, p, 8);
+            w.polys.push_back(x);
+            w.verdict.push_back(pending);
+        }
+        return;
+    }
+    const auto digit = [](const char ch) -> int_fast8_t {
+        if (ch >= '0' && ch <= '9') { return ch - '0'; }
+        if (ch >= 'a' && ch <= 'f') { return ch - 'a' + 10; }
+        if (ch >= 'A' && ch <= 'F') { return ch - 'A' + 10; }
+        return -1;
+    };
+    const auto space = [](const char ch) { return ch == ' ' || ch == '\t' || ch == '\r'; };
+    for (const char *p = c.begin; p < c.end;) {
+        const auto *eol = static_cast<const char *>(std::memchr(p, '\n', c.end - p));
+        const char *e = eol ? eol : c.end;
+        while (p < e && space(*p)) { ++p; }
+        while (e > p && space(e[-1])) { --e; }
+        if (e - p > 2 && p[0] == '0' && (p[1] == 'x' || p[1] == 'X')) { p += 2; }
+        uint_fast64_t x = 0;
+        bool ok = p < e && e - p <= 16;
+        for (; ok && p < e; ++p) {
+            const int_fast8_t v = digit(*p);
+            ok = v >= 0;
+            x = x << 4u | static_cast<uint_fast64_t>(v);
+        }
+        w.polys.push_back(ok ? x : 0);
+        w.verdict.push_back(ok ? pending : invalid);
+        if (!eol) { break; }
+        p = eol + 1;
+    }
+}
+
+/**
+ * Проверяет разобранные многочлены на неприводимость: многочлены
+ * порции группируются по степеням сортировкой подсчётом, и каждая
+ * группа проверяется одним вызовом Batch::Check, т.е. группами
+ * по Batch::Lanes() многочленов одновременно.
+ * @param[in,out] w рабочий поток с разобранной порцией.
+ */
+void Verifier::check(Worker &w) noexcept {
+    const std::size_t n = w.polys.size();
+    std::array<std::size_t, 65> start{};
+    for (std::size_t i = 0; i < n; ++i) {
+        if (w.verdict[i] != pending) { continue; }
+        if (w.polys[i] < 2) {
+            // константы не являются неприводимыми многочленами
+            w.verdict[i] = reducible;
+            continue;
+        }
+        ++start[64u - __builtin_clzll(w.polys[i])];
+    }
+    for (std::size_t d = 1; d < 65; ++d) { start[d] += start[d - 1]; }
+    const std::size_t m = start[64];
+    w.sorted.resize(m);
+    w.order.resize(m);
+    if (w.capacity < m) {
+        w.res.reset(new bool[m]);
+        w.capacity = m;
+    }
+    std::array<std::size_t, 65> next = start;
+    for (std::size_t i = 0; i < n; ++i) {
+        if (w.verdict[i] != pending) { continue; }
+        const std::size_t k = next[63u - __builtin_clzll(w.polys[i])]++;
+        w.sorted[k] = w.polys[i];
+        w.order[k] = static_cast<uint_fast32_t>(i);
+    }
+    for (uint_fast8_t d = 1; d < 64; ++d) {
+        if (start[d + 1] == start[d]) { continue; }
+        Batch::Check(w.sorted.data() + start[d], w.res.get() + start[d], start[d + 1] - start[d], d);
+    }
+    for (std::size_t k = 0; k < m; ++k) {
+        w.verdict[w.order[k]] = w.res[k] ? irreducible : reducible;
+    }
+}
+
+/**
+ * Цикл рабочего потока: забирает очередную порцию, разбирает и проверяет её
+ * и готовит вывод. Порции обрабатываются в произвольном порядке,
+ * порядок вывода восстанавливает writer.
+ * @param arg экземпляр Worker, принадлежащий данному потоку.
+ * @return nullptr после того, как все порции разобраны.
+ */
+void *Verifier::work(void *arg) noexcept {
+    auto *w = static_cast<Worker *>(arg);
+    auto *v = w->owner;
+    while (true) {
+        pthread_mutex_lock(&v->mutex);
+        while (v->taken == v->read && !v->finished) {
+            pthread_cond_wait(&v->hasWork, &v->mutex);
+        }
+        if (v->taken == v->read) {
+            pthread_mutex_unlock(&v->mutex);
+            break;
+        }
+        Chunk &c = v->chunks[v->taken++ % v->chunks.size()];
+        pthread_mutex_unlock(&v->mutex);
+
+        v->parse(*w, c);
+        v->check(*w);
+        const std::size_t n = w->verdict.size();
+        if (v->binary) {
+            c.out.assign(w->verdict.begin(), w->verdict.end());
+        } else {
+            c.out.resize(2 * n);
+            for (std::size_t i = 0; i < n; ++i) {
+                c.out[2 * i] = "01-"[w->verdict[i]];
+                c.out[2 * i + 1] = '\n';
+            }
+        }
+
+        pthread_mutex_lock(&v->mutex);
+        v->count += n;
+        c.ready = true;
+        pthread_cond_signal(&v->hasResult);
+        pthread_mutex_unlock(&v->mutex);
+    }
+    return nullptr;
+}
+
+/**
+ * Цикл потока вывода: записывает результаты порций строго в порядке
+ * их чтения и освобождает место для следующих. После ошибки записи
+ * порции продолжают забираться, чтобы конвейер не остановился.
+ * @param arg экземпляр Verifier.
+ * @return nullptr после записи последней порции.
+ */
+void *Verifier::writer(void *arg) noexcept {
+    auto *v = static_cast<Verifier *>(arg);
+    bool ok = true;
+    pthread_mutex_lock(&v->mutex);
+    while (true) {
+        Chunk &c = v->chunks[v->written % v->chunks.size()];
+        while (!c.ready && !(v->finished && v->written == v->read)) {
+            pthread_cond_wait(&v->hasResult, &v->mutex);
+        }
+        if (!c.ready) { break; }
+        pthread_mutex_unlock(&v->mutex);
+
+        for (std::size_t done = 0; ok && done < c.out.size();) {
+            const ssize_t n = ::write(v->output, c.out.data() + done, c.out.size() - done);
+            if (n > 0) { done += n; }
+            ok = n > 0 || (n < 0 && errno == EINTR);
+        }
+
+        pthread_mutex_lock(&v->mutex);
+        v->failed |= !ok;
+        c.ready = false;
+        ++v->written;
+        pthread_cond_signal(&v->hasSpace);
+    }
+    pthread_mutex_unlock(&v->mutex);
+    return nullptr;
+}
+
+/**
+ * Дожидается свободного места для очередной порции: одновременно
+ * в обработке находится не больше chunks.size() порций, поэтому
+ * чтение не опережает запись и память ограничена.
+ * @return свободная порция для заполнения вызывающим потоком.
+ */
+[[nodiscard]]
+Verifier::Chunk &Verifier::acquire() noexcept {
+    pthread_mutex_lock(&mutex);
+    while (read - written >= chunks.size()) {
+        pthread_cond_wait(&hasSpace, &mutex);
+    }
+    Chunk &c = chunks[read % chunks.size()];
+    pthread_mutex_unlock(&mutex);
+    return c;
+}
+
+/**
+ * Передаёт заполненную порцию рабочим потокам.
+ */
+void Verifier::submit() noexcept {
+    pthread_mutex_lock(&mutex);
+    ++read;
+    pthread_cond_signal(&hasWork);
+    pthread_mutex_unlock(&mutex);
+}
+
+/**
+ * Делит отображённый в память файл на порции без копирования:
+ * граница порции сдвигается к концу строки (или к границе 8 байт).
+ * @param[in] data начало файла.
+ * @param[in] size размер файла.
+ */
+void Verifier::mapped(const char *const data, const std::size_t size) noexcept {
+    const char *const end = data + size;
+    for (const char *p = data; p < end;) {
+        const char *q = p + std::min<std::size_t>(chunkBytes, end - p);
+        if (binary) {
+            q = p + (q - p) / 8 * 8;
+            if (q == p) {
+                // неполный многочлен в конце файла
+                pthread_mutex_lock(&mutex);
+                failed = true;
+                pthread_mutex_unlock(&mutex);
+                break;
+            }
+        } else {
+            while (q < end && q[-1] != '\n') { ++q; }
+        }
+        Chunk &c = acquire();
+        c.begin = p;
+        c.end = q;
+        submit();
+        p = q;
+    }
+}
+
+/**
+ * Читает поток (канал, терминал) порциями около chunkBytes байт.
+ * Незаконченная строка (или неполный многочлен) в конце порции
+ * переносится в начало следующей.
+ * @param[in] in дескриптор входного потока.
+ * @return удалось ли прочитать поток целиком.
+ */
+[[nodiscard]]
+bool Verifier::stream(const int in) noexcept {
+    std::vector<char> carry;
+    bool eof = false, ok = true;
+    while (!eof) {
+        Chunk &c = acquire();
+        c.storage.swap(carry);
+        carry.clear();
+        std::size_t scanned = 0, cut = 0;
+        while (!eof) {
+            const std::size_t old = c.storage.size();
+            c.storage.resize(old + chunkBytes);
+            const ssize_t n = ::read(in, c.storage.data() + old, chunkBytes);
+            c.storage.resize(old + std::max<ssize_t>(n, 0));
+            if (n < 0 && errno == EINTR) { continue; }
+            eof = n <= 0;
+            ok = n >= 0;
+            // порция заканчивается последним полным многочленом
+            if (binary) {
+                cut = c.storage.size() / 8 * 8;
+            } else {
+                for (std::size_t i = c.storage.size(); i > scanned; --i) {
+                    if (c.storage[i - 1] == '\n') {
+                        cut = i;
+                        break;
+                    }
+                }
+                scanned = c.storage.size();
+            }
+            if (c.storage.size() >= chunkBytes && cut > 0) { break; }
+        }
+        if (eof) {
+            ok &= !binary || c.storage.size() % 8 == 0;
+            cut = c.storage.size();
+        }
+        carry.assign(c.storage.begin() + cut, c.storage.end());
+        c.storage.resize(cut);
+        c.begin = c.storage.data();
+        c.end = c.begin + c.storage.size();
+        submit();
+    }
+    return ok;
+}
+
+/**
+ * Проверяет на неприводимость все многочлены входного потока и записывает
+ * результаты в том же порядке. Вход делится на порции: обычный файл
+ * отображается в память и делится без копирования, поток читается
+ * вызывающим потоком. Порции разбираются и проверяются всеми рабочими
+ * потоками одновременно (см. check), а отдельный поток записывает
+ * готовые результаты по порядку, поэтому чтение, проверка и запись
+ * идут одновременно.
+ * В текстовом формате на каждую входную строку выводится строка "1"
+ * (неприводим), "0" (приводим) или "-" (строка не разобрана).
+ * В двоичном формате на каждые 8 байт входа выводится байт 1 или 0.
+ * Степень каждого многочлена определяется его старшим коэффициентом.
+ * @param[in] in дескриптор входа.
+ * @param[in] out дескриптор выхода.
+ * @return удалось ли прочитать весь вход и записать все результаты.
+ */
+[[nodiscard]]
+bool Verifier::Run(const int in, const int out) noexcept {
+    output = out;
+    read = taken = written = count = 0;
+    finished = failed = false;
+    chunks = std::vector<Chunk>(2 * threadsNum + 2);
+    for (auto &c : chunks) { c.ready = false; }
+    workers = std::vector<Worker>(threadsNum);
+    for (auto &w : workers) {
+        w.owner = this;
+        w.capacity = 0;
+    }
+    for (uint_fast8_t i = 0; i < threadsNum; ++i) {
+        if (pthread_create(&workers[i].thread, nullptr, &work, &workers[i])) {
+            workers.resize(i);
+            break;
+        }
+    }
+    pthread_t thread;
+    const bool started = !workers.empty() && pthread_create(&thread, nullptr, &writer, this) == 0;
+
+    bool ok = started;
+    struct stat st{};
+    void *map = MAP_FAILED;
+    if (ok && fstat(in, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0) {
+        map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, in, 0);
+    }
+    if (ok && map != MAP_FAILED) {
+        madvise(map, st.st_size, MADV_SEQUENTIAL);
+        mapped(static_cast<const char *>(map), st.st_size);
+    } else if (ok) {
+        ok = stream(in);
+    }
+
+    pthread_mutex_lock(&mutex);
+    finished = true;
+    pthread_cond_broadcast(&hasWork);
+    pthread_cond_signal(&hasResult);
+    pthread_mutex_unlock(&mutex);
+    for (auto &w : workers) { pthread_join(w.thread, nullptr); }
+    if (started) { pthread_join(thread, nullptr); }
+    if (map != MAP_FAILED) { munmap(map, st.st_size); }
+    workers.clear();
+    chunks.clear();
+    return ok && !failed;
+}
+
+/**
+ * @return число многочленов, проверенных последним вызовом Run.
+ */
+[[nodiscard]]
+uint_fast64_t Verifier::Count() const noexcept {
+    return count;
+}
@@ -0,0 +1,97 @@
+/**
+ * @file    Verifier.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_VERIFIER_HPP
+#define BERLEKAMP_VERIFIER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <pthread.h>
+
+class Verifier {
+    /// примерный размер порции входных данных в байтах
+    static constexpr std::size_t chunkBytes = 1u << 20u;
+
+    struct Chunk {
+        std::vector<char> storage;
+        const char *begin;
+        const char *end;
+        std::vector<char> out;
+        bool ready;
+    };
+
+    struct Worker {
+        Verifier *owner;
+        pthread_t thread;
+        std::vector<uint_fast64_t> polys;
+        std::vector<uint_fast64_t> sorted;
+        std::vector<uint_fast32_t> order;
+        std::vector<uint_fast8_t> verdict;
+        std::unique_ptr<bool[]> res;
+        std::size_t capacity;
+    };
+
+    std::vector<Chunk> chunks;
+    std::vector<Worker> workers;
+
+    pthread_mutex_t mutex;
+    pthread_cond_t hasWork;
+    pthread_cond_t hasResult;
+    pthread_cond_t hasSpace;
+
+    uint_fast64_t read;
+    uint_fast64_t taken;
+    uint_fast64_t written;
+    uint_fast64_t count;
+    uint_fast8_t threadsNum;
+    int output;
+    bool binary;
+    bool finished;
+    bool failed;
+
+    static
+    void *work(void *) noexcept;
+
+    static
+    void *writer(void *) noexcept;
+
+    void parse(Worker &, const Chunk &) noexcept;
+
+    void check(Worker &) noexcept;
+
+    [[nodiscard]]
+    Chunk &acquire() noexcept;
+
+    void submit() noexcept;
+
+    void mapped(const char *, std::size_t) noexcept;
+
+    [[nodiscard]]
+    bool stream(int) noexcept;
+
+public:
+    explicit
+    Verifier(uint_fast8_t = 0, bool = false) noexcept;
+
+    Verifier(const Verifier &) = delete;
+
+    Verifier &operator=(const Verifier &) = delete;
+
+    ~Verifier() noexcept;
+
+    [[nodiscard]]
+    bool Run(int, int) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Count() const noexcept;
+};
+
+#endif //BERLEKAMP_VERIFIER_HPP
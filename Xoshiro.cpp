@@ -0,0 +1,70 @@
+/**
+ * @file    Xoshiro.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include "Xoshiro.hpp"
+
+/**
+ * Создаёт генератор xoshiro256** (Блэкман и Винья) с периодом 2^256 - 1.
+ * Состояние заполняется генератором SplitMix64 из начального значения,
+ * поэтому близкие начальные значения дают несвязанные последовательности,
+ * а нулевое состояние, на котором xoshiro вырождается, не возникает.
+ * @param[in] seed начальное значение.
+ */
+Xoshiro::Xoshiro(uint_fast64_t seed) noexcept : s() {
+    for (auto &x : s) {
+        seed += 0x9E'37'79'B9'7F'4A'7C'15ull;
+        uint_fast64_t z = seed;
+        z = (z ^ (z >> 30u)) * 0xBF'58'47'6D'1C'E4'E5'B9ull;
+        z = (z ^ (z >> 27u)) * 0x94'D0'49'BB'13'31'11'EBull;
+        x = z ^ (z >> 31u);
+    }
+}
+
+/**
+ * @return очередное 64-битное псевдослучайное число, старшие биты
+ * которого годятся для получения чисел меньшей длины сдвигом вправо.
+ */
+[[nodiscard]]
+uint_fast64_t Xoshiro::Next() noexcept {
+    const auto rotl = [](const uint_fast64_t x, const uint_fast8_t k) {
+        return (x << k) | (x >> (64u - k));
+    };
+    const uint_fast64_t res = rotl(s[1] * 5u, 7u) * 9u;
+    const uint_fast64_t t = s[1] << 17u;
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45u);
+    return res;
+}
+
+/**
+ * Продвигает генератор на 2^128 шагов, т.е. эквивалентен 2^128 вызовам Next.
+ * Последовательные вызовы Jump от одного начального значения дают
+ * до 2^128 непересекающихся подпоследовательностей: рабочий поток номер i
+ * генерирует кандидатов из состояния, продвинутого i раз.
+ */
+void Xoshiro::Jump() noexcept {
+    static constexpr uint_fast64_t jump[4] = {
+            0x18'0E'C6'D3'3C'FD'0A'BAull, 0xD5'A6'12'66'F0'C9'39'2Cull,
+            0xA9'58'26'18'E0'3F'C9'AAull, 0x39'AB'DC'45'29'B1'66'1Cull
+    };
+    std::array<uint_fast64_t, 4> t{};
+    for (auto j : jump) {
+        for (uint_fast8_t b = 0; b < 64; ++b) {
+            if ((j >> b) & 1u) {
+                for (uint_fast8_t i = 0; i < 4; ++i) { t[i] ^= s[i]; }
+            }
+            (void) Next();
+        }
+    }
+    s = t;
+}
@@ -0,0 +1,29 @@
+/**
+ * @file    Xoshiro.hpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#ifndef BERLEKAMP_XOSHIRO_HPP
+#define BERLEKAMP_XOSHIRO_HPP
+
+#include <array>
+#include <cstdint>
+
+class Xoshiro {
+    std::array<uint_fast64_t, 4> s;
+
+public:
+    explicit
+    Xoshiro(uint_fast64_t = 0) noexcept;
+
+    [[nodiscard]]
+    uint_fast64_t Next() noexcept;
+
+    void Jump() noexcept;
+};
+
+#endif //BERLEKAMP_XOSHIRO_HPP
@@ -0,0 +1,76 @@
+/**
+ * @file    bench.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include "Benchmark.hpp"
+
+using namespace std;
+
+/**
+ * Выполняет замеры и выводит их в формате JSON (см. Benchmark::Write).
+ * Параметры:
+ *   --out FILE        записать результаты в FILE вместо стандартного вывода;
+ *   --baseline FILE   сравнить с результатами из FILE (см. Benchmark::Compare);
+ *   --threshold PCT   допустимое замедление в процентах, по умолчанию 10;
+ *   --seed N          начальное значение генератора кандидатов, по умолчанию 1;
+ *   --count N         число кандидатов каждой степени, по умолчанию 100000;
+ *   --threads N       число рабочих потоков генератора, по умолчанию по числу ядер;
+ *   --from D, --to D  диапазон степеней, по умолчанию от 1 до 63;
+ *   --enumerate D     дополнительно замерить полный перебор и перечисление
+ *                     по словам Линдона до степени D.
+ * @return 0, 1 если есть замедления больше допустимого, 2 при ошибке параметров.
+ */
+int main(int argc, char *argv[]) {
+    const char *out = nullptr, *baseline = nullptr;
+    double threshold = 10.0;
+    unsigned long long seed = 1, count = 100000;
+    unsigned threads = 0, from = 1, to = 63, enumerate = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const char *key = argv[i], *value = argv[i + 1];
+        if (!strcmp(key, "--out")) { out = value; }
+        else if (!strcmp(key, "--baseline")) { baseline = value; }
+        else if (!strcmp(key, "--threshold")) { threshold = strtod(value, nullptr); }
+        else if (!strcmp(key, "--seed")) { seed = strtoull(value, nullptr, 10); }
+        else if (!strcmp(key, "--count")) { count = strtoull(value, nullptr, 10); }
+        else if (!strcmp(key, "--threads")) { threads = strtoul(value, nullptr, 10); }
+        else if (!strcmp(key, "--from")) { from = strtoul(value, nullptr, 10); }
+        else if (!strcmp(key, "--to")) { to = strtoul(value, nullptr, 10); }
+        else if (!strcmp(key, "--enumerate")) { enumerate = strtoul(value, nullptr, 10); }
+        else {
+            cerr << "unknown option " << key << endl;
+            return 2;
+        }
+    }
+    if (argc % 2 == 0 || from < 1 || from > to || to > 63 || enumerate > 63 || count == 0 || threads > 255) {
+        cerr << "usage: " << argv[0] << " [--out FILE] [--baseline FILE] [--threshold PCT] [--seed N]"
+             << " [--count N] [--threads N] [--from D] [--to D] [--enumerate D]" << endl;
+        return 2;
+    }
+
+    Benchmark benchmark(seed, count, threads);
+    benchmark.Run(from, to);
+    if (enumerate >= 2) { benchmark.Enumerate(enumerate); }
+    if (out) {
+        ofstream file(out);
+        benchmark.Write(file);
+    } else {
+        benchmark.Write(cout);
+    }
+    if (!baseline) { return 0; }
+    ifstream file(baseline);
+    const auto base = Benchmark::Read(file);
+    if (base.empty()) {
+        cerr << "no results in " << baseline << endl;
+        return 2;
+    }
+    return Benchmark::Compare(base, benchmark.Results(), threshold / 100.0, cerr) ? 1 : 0;
+}
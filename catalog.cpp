@@ -0,0 +1,92 @@
+/**
+ * @file    catalog.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Catalog.hpp"
+
+using namespace std;
+
+/**
+ * Строит каталог неприводимых многочленов или выполняет запросы к нему.
+ * Команды:
+ *   build FILE [--full D] [--max D] [--samples N] [--threads N]
+ *                              построить каталог (см. Catalog::Build),
+ *                              по умолчанию full = 24, max = 63, samples = 4096;
+ *   info FILE                  вывести число многочленов каждой степени;
+ *   select FILE D K            вывести K-й многочлен степени D;
+ *   rank FILE D P              вывести число многочленов степени D, меньших P;
+ *   sample FILE D N [SEED]     вывести N случайных многочленов степени D.
+ * Многочлены выводятся и принимаются в шестнадцатеричном виде.
+ * @return 0, 1 если файл не удалось построить или открыть, 2 при ошибке параметров.
+ */
+int main(int argc, char *argv[]) {
+    const char *usage = " build FILE [--full D] [--max D] [--samples N] [--threads N]\n"
+                        "       | info FILE | select FILE D K | rank FILE D P | sample FILE D N [SEED]";
+    if (argc < 3) {
+        cerr << "usage: " << argv[0] << usage << endl;
+        return 2;
+    }
+    const char *command = argv[1], *path = argv[2];
+
+    if (!strcmp(command, "build")) {
+        unsigned full = 24, max = 63, threads = 0;
+        unsigned long long samples = 4096;
+        for (int i = 3; i + 1 < argc; i += 2) {
+            const char *key = argv[i], *value = argv[i + 1];
+            if (!strcmp(key, "--full")) { full = strtoul(value, nullptr, 10); }
+            else if (!strcmp(key, "--max")) { max = strtoul(value, nullptr, 10); }
+            else if (!strcmp(key, "--samples")) { samples = strtoull(value, nullptr, 10); }
+            else if (!strcmp(key, "--threads")) { threads = strtoul(value, nullptr, 10); }
+            else {
+                cerr << "unknown option " << key << endl;
+                return 2;
+            }
+        }
+        if (argc % 2 == 0 || max < 1 || max > 63 || full > max || threads > 255) {
+            cerr << "usage: " << argv[0] << usage << endl;
+            return 2;
+        }
+        if (!Catalog::Build(path, full, max, samples, threads)) {
+            cerr << "failed to build " << path << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    Catalog catalog(path);
+    if (!catalog.IsOpen()) {
+        cerr << "failed to open " << path << endl;
+        return 1;
+    }
+    const unsigned long degree = argc > 3 ? strtoul(argv[3], nullptr, 10) : 0;
+    cout << hex;
+    if (!strcmp(command, "info") && argc == 3) {
+        cout << dec;
+        for (uint_fast8_t d = 1; d < 64; ++d) {
+            if (!catalog.Count(d)) { continue; }
+            cout << unsigned(d) << ' ' << catalog.Count(d)
+                 << (catalog.IsComplete(d) ? " complete" : " sampled") << endl;
+        }
+    } else if (!strcmp(command, "select") && argc == 5 && degree < 64) {
+        cout << catalog.Select(degree, strtoull(argv[4], nullptr, 10)) << endl;
+    } else if (!strcmp(command, "rank") && argc == 5 && degree < 64) {
+        cout << dec << catalog.Rank(degree, strtoull(argv[4], nullptr, 16)) << endl;
+    } else if (!strcmp(command, "sample") && (argc == 5 || argc == 6) && degree < 64) {
+        Xoshiro rng(argc == 6 ? strtoull(argv[5], nullptr, 10) : 1);
+        for (unsigned long long n = strtoull(argv[4], nullptr, 10); n > 0; --n) {
+            cout << catalog.Sample(degree, rng) << endl;
+        }
+    } else {
+        cerr << "usage: " << argv[0] << usage << endl;
+        return 2;
+    }
+    return 0;
+}
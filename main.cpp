@@ -1,6 +1,11 @@
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
+#include <fcntl.h>
+#include <unistd.h>
 #include "Generator.hpp"
+#include "Verifier.hpp"
 
 using namespace std;
 
@@ -12,59 +17,44 @@ ostream &print(ostream &out, const uint_fast64_t p) {
     return out;
 }
 
-#ifdef TIMINGS
-
-#include <chrono>
-#include <fstream>
-#include "Polynomial.hpp"
-
-uint_fast64_t GenerateAll(const uint_fast8_t degree) {
-    const uint_fast64_t n = (1ull << (degree - 1u));
-    uint_fast64_t res = 0;
-    for (uint_fast64_t i = 0; i < n; ++i) {
-        res += Polynomial((1ull << degree) | (i << 1ull) | 1ull)
-                .IsIrredusible(degree);
+/**
+ * Без параметров выводит случайный неприводимый многочлен степени 48.
+ * irrpolygf2 verify [--binary] [--threads N] [FILE] проверяет многочлены
+ * из FILE или стандартного ввода и выводит результаты по порядку
+ * (см. Verifier::Run).
+ * @return 0, 1 при ошибке ввода-вывода, 2 при ошибке параметров.
+ */
+int main(int argc, char *argv[]) {
+    if (argc == 1) {
+        Generator generator;
+        print(cout, generator.GetIrrPoly(48));
+        return 0;
     }
-    return res;
-}
-
-void WriteTimings(const char file[]) {
-    ofstream out(file);
-    chrono::steady_clock::time_point start, end;
-    uint_fast64_t res;
-    for (uint_fast8_t i = 2; i <= 63; ++i) {
-        start = chrono::steady_clock::now();
-        res = GenerateAll(i);
-        end = chrono::steady_clock::now();
-        out << "deg: " << +i << endl
-            << "num: " << res << endl
-            << "mic: "
-            << chrono::duration_cast<chrono::microseconds>(end - start).count()
-            << endl
-            << "mil: "
-            << chrono::duration_cast<chrono::milliseconds>(end - start).count()
-            << endl
-            << "sec: "
-            << chrono::duration_cast<chrono::seconds>(end - start).count()
-            << endl
-            << "min: "
-            << chrono::duration_cast<chrono::minutes>(end - start).count()
-            << endl
-            << "hou: "
-            << chrono::duration_cast<chrono::hours>(end - start).count()
-            << endl
-            << endl;
-        out.flush();
+    bool binary = false, ok = !strcmp(argv[1], "verify");
+    unsigned threads = 0;
+    const char *path = nullptr;
+    for (int i = 2; ok && i < argc; ++i) {
+        if (!strcmp(argv[i], "--binary")) { binary = true; }
+        else if (!strcmp(argv[i], "--threads") && i + 1 < argc) { threads = strtoul(argv[++i], nullptr, 10); }
+        else if (!path && argv[i][0] != '-') { path = argv[i]; }
+        else { ok = false; }
+    }
+    if (!ok || threads > 255) {
+        cerr << "usage: " << argv[0] << " [verify [--binary] [--threads N] [FILE]]" << endl;
+        return 2;
     }
-    out.close();
-}
-
-#endif
 
-int main() {
-    print(cout, Generator::GetIrrPoly(48));
-#ifdef TIMINGS
-    WriteTimings("timings.txt");
-#endif
+    const int in = path ? open(path, O_RDONLY) : STDIN_FILENO;
+    if (in < 0) {
+        cerr << "failed to open " << path << endl;
+        return 1;
+    }
+    Verifier verifier(threads, binary);
+    ok = verifier.Run(in, STDOUT_FILENO);
+    if (path) { close(in); }
+    if (!ok) {
+        cerr << "verification failed after " << verifier.Count() << " polynomials" << endl;
+        return 1;
+    }
     return 0;
 }
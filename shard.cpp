@@ -0,0 +1,87 @@
+/**
+ * @file    shard.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include "Polynomial.hpp"
+#include "Shard.hpp"
+
+using namespace std;
+
+/**
+ * Полный перебор многочленов заданной степени частями, которые можно
+ * выполнять отдельными процессами и продолжать после сбоя (см. Shard).
+ * Команды:
+ *   run PREFIX D I K [--polys] [--threads N] [--interval S]
+ *                              выполнить или продолжить часть I из K
+ *                              перебора степени D (см. Shard::Run),
+ *                              по умолчанию контрольная точка раз в 60 секунд;
+ *   status PREFIX D K          вывести состояние каждой части;
+ *   merge PREFIX D K [--out FILE]
+ *                              объединить части и сверить результат
+ *                              с формулой Гаусса (см. Shard::Merge).
+ * @return 0, 1 если часть не выполнена или результат не сходится,
+ * 2 при ошибке параметров.
+ */
+int main(int argc, char *argv[]) {
+    const char *usage = " run PREFIX D I K [--polys] [--threads N] [--interval S]\n"
+                        "       | status PREFIX D K | merge PREFIX D K [--out FILE]";
+    const bool run = argc >= 2 && !strcmp(argv[1], "run");
+    const int options = run ? 6 : 5;
+    if (argc < options || (strcmp(argv[1], "run") && strcmp(argv[1], "status") && strcmp(argv[1], "merge"))) {
+        cerr << "usage: " << argv[0] << usage << endl;
+        return 2;
+    }
+    const char *command = argv[1], *prefix = argv[2], *out = nullptr;
+    const unsigned long degree = strtoul(argv[3], nullptr, 10);
+    const unsigned long long index = run ? strtoull(argv[4], nullptr, 10) : 0;
+    const unsigned long long shards = strtoull(argv[options - 1], nullptr, 10);
+    unsigned threads = 0, interval = 60;
+    bool polys = false, ok = degree >= 1 && degree <= 63 && shards > 0 && index < shards;
+    for (int i = options; ok && i < argc; ++i) {
+        if (run && !strcmp(argv[i], "--polys")) { polys = true; }
+        else if (run && !strcmp(argv[i], "--threads") && i + 1 < argc) { threads = strtoul(argv[++i], nullptr, 10); }
+        else if (run && !strcmp(argv[i], "--interval") && i + 1 < argc) { interval = strtoul(argv[++i], nullptr, 10); }
+        else if (!strcmp(command, "merge") && !strcmp(argv[i], "--out") && i + 1 < argc) { out = argv[++i]; }
+        else { ok = false; }
+    }
+    if (!ok || threads > 255) {
+        cerr << "usage: " << argv[0] << usage << endl;
+        return 2;
+    }
+
+    if (run) {
+        if (!Shard::Run(prefix, degree, index, shards, polys, threads, interval)) {
+            cerr << "shard " << index << " of " << shards << " failed" << endl;
+            return 1;
+        }
+        Shard::Checkpoint c{};
+        if (Shard::Load(prefix, degree, index, shards, c)) { cout << c.count << endl; }
+        return 0;
+    }
+
+    if (!strcmp(command, "status")) {
+        for (unsigned long long i = 0; i < shards; ++i) {
+            Shard::Checkpoint c{};
+            if (!Shard::Load(prefix, degree, i, shards, c)) {
+                cout << i << " not started" << endl;
+                continue;
+            }
+            cout << i << ' ' << c.next - c.first << '/' << c.last - c.first << ' ' << c.count
+                 << (c.next == c.last ? " done" : "") << endl;
+        }
+        return 0;
+    }
+
+    uint_fast64_t count = 0;
+    ok = Shard::Merge(prefix, degree, shards, out, count);
+    cout << count << ' ' << Polynomial<>::Count(degree) << (ok ? " ok" : " mismatch") << endl;
+    return ok ? 0 : 1;
+}
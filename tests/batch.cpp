@@ -0,0 +1,102 @@
+/**
+ * @file    batch.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+#include "Batch.hpp"
+#include "Polynomial.hpp"
+#include "Rank.hpp"
+#include "Xoshiro.hpp"
+
+using namespace std;
+
+/// число случайных многочленов и матриц каждой степени
+static const size_t samples = 1000;
+
+/**
+ * Случайный многочлен степени degree: в основном с ненулевым свободным
+ * членом, как у кандидатов генератора, иногда квадрат (нулевая производная)
+ * или многочлен, делящийся на x, чтобы проверить ранние выходы.
+ */
+static uint_fast64_t candidate(Xoshiro &rng, const uint_fast8_t degree) {
+    const uint_fast64_t r = rng.Next();
+    uint_fast64_t p = (1ull << degree) | (r >> (64u - degree));
+    if ((r & 15u) == 0) { return p & ~1ull; }
+    if ((r & 15u) == 1 && degree % 2 == 0) {
+        const uint_fast64_t q = (1ull << (degree / 2u)) | (r >> (64u - degree / 2u));
+        p = 0;
+        for (uint_fast8_t i = 0; i <= degree / 2u; ++i) { p |= ((q >> i) & 1u) << (2u * i); }
+        return p;
+    }
+    return p | 1u;
+}
+
+/**
+ * Сравнивает Batch::Check (все алгоритмы и все ширины векторов,
+ * доступные на процессоре) и Rank::Get (все векторные ядра) с проверкой
+ * по одному алгоритмом Рабина, не использующим ранг, и с Rank::Portable
+ * на случайных многочленах и матрицах всех степеней от 1 до 63.
+ * @return 0, 1 если найдено расхождение.
+ */
+int main() {
+    Xoshiro rng(1);
+    vector<uint_fast64_t> polys(samples);
+    vector<bool> expected(samples);
+    bool res[samples];
+    size_t failures = 0;
+
+    const uint_fast8_t lanes[] = {16, 8, 1};
+    const Polynomial<>::Method methods[] = {
+            Polynomial<>::Method::Auto, Polynomial<>::Method::Berlekamp, Polynomial<>::Method::Rabin};
+    const uint_fast16_t kernels[] = {512, 256, 0};
+    for (uint_fast8_t degree = 1; degree < 64; ++degree) {
+        for (size_t i = 0; i < samples; ++i) {
+            polys[i] = candidate(rng, degree);
+            expected[i] = Polynomial(polys[i]).IsIrredusible(degree, Polynomial<>::Method::Rabin);
+        }
+        for (const auto l : lanes) {
+            if (l > Batch::Lanes()) { continue; }
+            Batch::Limit(l);
+            for (const auto m : methods) {
+                Batch::Check(polys.data(), res, samples, degree, m);
+                for (size_t i = 0; i < samples; ++i) {
+                    if (res[i] == expected[i]) { continue; }
+                    if (++failures <= 10) {
+                        cerr << "Batch::Check lanes " << +l << " method " << +static_cast<uint_fast8_t>(m)
+                             << " degree " << +degree << " poly " << polys[i] << endl;
+                    }
+                }
+            }
+            Batch::Limit(16);
+        }
+
+        for (size_t i = 0; i < samples; ++i) {
+            // часть строк - суммы предыдущих, чтобы ранг был неполным
+            uint_fast64_t M[63], copy[63];
+            for (uint_fast8_t r = 0; r < degree; ++r) {
+                M[r] = rng.Next() >> (64u - degree);
+                if (r > 0 && (rng.Next() & 3u) == 0) { M[r] = M[r - 1] ^ M[rng.Next() % r]; }
+            }
+            copy_n(M, degree, copy);
+            const uint_fast8_t rank = Rank::Portable(copy, degree);
+            for (const auto k : kernels) {
+                if (k > Rank::Hardware()) { continue; }
+                Rank::Limit(k);
+                copy_n(M, degree, copy);
+                if (Rank::Get(copy, degree) != rank && ++failures <= 10) {
+                    cerr << "Rank::Get kernel " << k << " degree " << +degree << endl;
+                }
+                Rank::Limit(512);
+            }
+        }
+    }
+    if (failures) { cerr << failures << " mismatches" << endl; }
+    return failures ? 1 : 0;
+}
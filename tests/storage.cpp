@@ -0,0 +1,131 @@
+/**
+ * @file    storage.cpp
+ * @author  Vadim Piven <vadim@piven.tech>
+ * @date    2026/10/16
+ * @license Free use of this library is permitted under the
+ * guidelines and in accordance with the MIT License (MIT).
+ * @url     https://github.com/vadimpiven/irrpolygf2
+ */
+
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+#include <unistd.h>
+#include "Catalog.hpp"
+#include "Polynomial.hpp"
+#include "Shard.hpp"
+
+using namespace std;
+
+/// число ошибок, найденных проверками
+static size_t failures = 0;
+
+/**
+ * Учитывает результат проверки и выводит описание ошибки.
+ */
+static void expect(const bool ok, const string &what) {
+    if (!ok && ++failures <= 10) { cerr << what << endl; }
+}
+
+/**
+ * Строит каталог (все многочлены до степени 16, по 1000 случайных
+ * до степени 24), открывает его заново и сверяет Count, Select, Rank
+ * и Contains с формулой Гаусса и полным перебором.
+ */
+static void catalog() {
+    const char *path = "test_storage.catalog";
+    const uint_fast8_t full = 16, max = 24;
+    const size_t samples = 1000;
+    expect(Catalog::Build(path, full, max, samples), "Catalog::Build failed");
+    Catalog c;
+    expect(c.Open(path), "Catalog::Open failed");
+    if (!c.IsOpen()) { return; }
+
+    for (uint_fast8_t d = 1; d <= full; ++d) {
+        const string at = "degree " + to_string(d);
+        expect(c.IsComplete(d) && c.Count(d) == Polynomial<>::Count(d), at + ": Count");
+        uint_fast64_t k = 0;
+        for (uint_fast64_t p = 1ull << d; p < (2ull << d); ++p) {
+            const bool irr = Polynomial(p).IsIrredusible(d, Polynomial<>::Method::Rabin);
+            expect(c.Contains(d, p) == irr, at + ": Contains " + to_string(p));
+            expect(c.Rank(d, p) == k, at + ": Rank " + to_string(p));
+            if (irr) { expect(c.Select(d, k++) == p, at + ": Select " + to_string(p)); }
+        }
+    }
+    for (uint_fast8_t d = full + 1; d <= max; ++d) {
+        const string at = "degree " + to_string(d);
+        expect(!c.IsComplete(d) && c.Count(d) == samples, at + ": Count");
+        uint_fast64_t last = 0;
+        for (uint_fast64_t k = 0; k < c.Count(d); ++k) {
+            const uint_fast64_t p = c.Select(d, k);
+            expect(p > last && p >> d == 1 && Polynomial(p).IsIrredusible(d), at + ": Select " + to_string(k));
+            expect(c.Rank(d, p) == k && c.Contains(d, p), at + ": Rank " + to_string(p));
+            last = p;
+        }
+    }
+    for (uint_fast8_t d = max + 1; d < 64; ++d) {
+        expect(c.Count(d) == 0 && c.Select(d, 0) == 0, "degree " + to_string(d) + ": not empty");
+    }
+    c.Close();
+    remove(path);
+}
+
+/**
+ * Перебирает степень 20 тремя частями, обрезает файл результатов
+ * одной из них, проверяет, что Merge это замечает, повторяет часть
+ * и сверяет объединённый результат с формулой Гаусса.
+ */
+static void shard() {
+    const char *prefix = "test_storage";
+    const uint_fast8_t degree = 20;
+    const uint_fast64_t shards = 3;
+    const string out = string(prefix) + ".out";
+    const auto name = [prefix](const uint_fast64_t i, const char *ext) {
+        return string(prefix) + ".20." + to_string(i) + "-of-3." + ext;
+    };
+    // остатки прошлого запуска продолжили бы перебор
+    for (uint_fast64_t i = 0; i < shards; ++i) {
+        remove(name(i, "ckpt").c_str());
+        remove(name(i, "bin").c_str());
+    }
+
+    for (uint_fast64_t i = 0; i < shards; ++i) {
+        expect(Shard::Run(prefix, degree, i, shards, true, 0, 1), "Shard::Run " + to_string(i));
+    }
+    expect(truncate(name(1, "bin").c_str(), 800) == 0, "truncate");
+    uint_fast64_t count = 0;
+    expect(!Shard::Merge(prefix, degree, shards, out.c_str(), count), "Merge accepted a truncated shard");
+    expect(Shard::Run(prefix, degree, 1, shards, true, 0, 1), "Shard::Run after truncation");
+    expect(Shard::Merge(prefix, degree, shards, out.c_str(), count), "Shard::Merge");
+    expect(count == Polynomial<>::Count(degree), "Merge count " + to_string(count));
+
+    ifstream in(out, ios::binary);
+    vector<uint64_t> polys(Polynomial<>::Count(degree) + 1);
+    in.read(reinterpret_cast<char *>(polys.data()), static_cast<streamsize>(8 * polys.size()));
+    polys.resize(static_cast<size_t>(in.gcount()) / 8);
+    expect(polys.size() == Polynomial<>::Count(degree), "merged file size");
+    unordered_set<uint64_t> seen;
+    for (const auto p : polys) {
+        expect(seen.insert(p).second && Polynomial(p).IsIrredusible(degree), "merged " + to_string(p));
+    }
+    for (uint_fast64_t i = 0; i < shards; ++i) {
+        remove(name(i, "ckpt").c_str());
+        remove(name(i, "bin").c_str());
+    }
+    remove(out.c_str());
+}
+
+/**
+ * Проверяет на небольших степенях оба формата хранения на диске:
+ * каталог (см. Catalog) и контрольные точки частей перебора (см. Shard).
+ * @return 0, 1 если найдена ошибка.
+ */
+int main() {
+    catalog();
+    shard();
+    if (failures) { cerr << failures << " failures" << endl; }
+    return failures ? 1 : 0;
+}